@@ -0,0 +1,15 @@
+/**
+ * aldous_broder_wilson.cpp
+ *
+ * By Sebastian Raaphorst, 2018.
+ *
+ * Generate a maze using Aldous-Broder for half of the cells and Wilson's algorithm for the rest.
+ */
+
+#include <maze/AldousBroderWilsonMazeGenerator.h>
+
+#include "Executor.h"
+
+int main(int argc, char *argv[]) {
+    return Executor<spelunker::maze::AldousBroderWilsonMazeGenerator>::generateAndDisplayMaze(argc, argv);
+}
@@ -0,0 +1,97 @@
+/**
+ * app_benchmark_generators.cpp
+ *
+ * By Sebastian Raaphorst, 2018.
+ *
+ * Time the generation of large mazes.
+ * Usage: app_benchmark_generators [width height [repetitions]]
+ */
+
+#include <chrono>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <maze/AldousBroderWilsonMazeGenerator.h>
+#include <maze/BFSMazeGenerator.h>
+#include <maze/BinaryTreeMazeGenerator.h>
+#include <maze/DFSMazeGenerator.h>
+#include <maze/EllerMazeGenerator.h>
+#include <maze/GrowingTreeMazeGenerator.h>
+#include <maze/HuntAndKillMazeGenerator.h>
+#include <maze/KruskalMazeGenerator.h>
+#include <maze/Maze.h>
+#include <maze/MazeGenerator.h>
+#include <maze/OriginShiftMazeGenerator.h>
+#include <maze/ParallelBFSMazeGenerator.h>
+#include <maze/ParallelBinaryTreeMazeGenerator.h>
+#include <maze/ParallelKruskalMazeGenerator.h>
+#include <maze/ParallelRecursiveDivisionMazeGenerator.h>
+#include <maze/ParallelSidewinderMazeGenerator.h>
+#include <maze/ProppWilsonMazeGenerator.h>
+#include <maze/RecursiveDivisionMazeGenerator.h>
+#include <maze/SidewinderMazeGenerator.h>
+#include <maze/TiledMazeGenerator.h>
+#include <maze/WilsonMazeGenerator.h>
+
+#include "Utils.h"
+
+using namespace spelunker;
+
+int main(int argc, char *argv[]) {
+    if (argc != 1 && argc != 3 && argc != 4) {
+        std::cerr << "Usage: " << argv[0] << " [width height [repetitions]]" << std::endl;
+        return 1;
+    }
+
+    const auto width = argc > 1 ? static_cast<int>(Utils::parseLong(argv[1])) : 4096;
+    const auto height = argc > 1 ? static_cast<int>(Utils::parseLong(argv[2])) : 4096;
+    const auto repetitions = argc > 3 ? static_cast<int>(Utils::parseLong(argv[3])) : 1;
+    if (width <= 0 || height <= 0 || repetitions <= 0) {
+        std::cerr << "Dimensions and repetitions must be positive integers." << std::endl;
+        return 1;
+    }
+
+    using Factory = std::function<const maze::Maze()>;
+    using Strategy = maze::GrowingTreeMazeGenerator::CellSelectionStrategy;
+    const std::vector<std::pair<std::string, Factory>> generators {
+            {"aldous_broder_wilson", [=] { return maze::AldousBroderWilsonMazeGenerator{width, height}.generate(); }},
+            {"bfs", [=] { return maze::BFSMazeGenerator{width, height}.generate(); }},
+            {"binarytree", [=] { return maze::BinaryTreeMazeGenerator{width, height}.generate(); }},
+            {"dfs",     [=] { return maze::DFSMazeGenerator{width, height}.generate(); }},
+            {"eller",   [=] { return maze::EllerMazeGenerator{width, height}.generate(); }},
+            {"growing_tree_middle", [=] { return maze::GrowingTreeMazeGenerator{width, height, Strategy::MIDDLE}.generate(); }},
+            {"growing_tree_random", [=] { return maze::GrowingTreeMazeGenerator{width, height, Strategy::RANDOM}.generate(); }},
+            {"growing_tree_mixed", [=] { return maze::GrowingTreeMazeGenerator{width, height,
+                    {{Strategy::NEWEST, 0.75}, {Strategy::RANDOM, 0.25}}}.generate(); }},
+            {"hunt_and_kill", [=] { return maze::HuntAndKillMazeGenerator{width, height}.generate(); }},
+            {"kruskal", [=] { return maze::KruskalMazeGenerator{width, height}.generate(); }},
+            {"origin_shift", [=] { return maze::OriginShiftMazeGenerator{width, height}.generate(); }},
+            {"parallel_bfs", [=] { return maze::ParallelBFSMazeGenerator{width, height}.generate(); }},
+            {"parallel_binarytree", [=] { return maze::ParallelBinaryTreeMazeGenerator{width, height}.generate(); }},
+            {"parallel_kruskal", [=] { return maze::ParallelKruskalMazeGenerator{width, height}.generate(); }},
+            {"parallel_recursive_division", [=] { return maze::ParallelRecursiveDivisionMazeGenerator{width, height}.generate(); }},
+            {"parallel_sidewinder", [=] { return maze::ParallelSidewinderMazeGenerator{width, height}.generate(); }},
+            {"propp_wilson", [=] { return maze::ProppWilsonMazeGenerator{width, height}.generate(); }},
+            {"recursive_division", [=] { return maze::RecursiveDivisionMazeGenerator{width, height}.generate(); }},
+            {"sidewinder", [=] { return maze::SidewinderMazeGenerator{width, height}.generate(); }},
+            {"tiled_dfs", [=] { return maze::TiledMazeGenerator{width, height, 256, 256,
+                    maze::TiledMazeGenerator::factoryFor<maze::DFSMazeGenerator>()}.generate(); }},
+            {"tiled_wilson", [=] { return maze::TiledMazeGenerator{width, height, 256, 256,
+                    maze::TiledMazeGenerator::factoryFor<maze::WilsonMazeGenerator>()}.generate(); }},
+            {"wilson",  [=] { return maze::WilsonMazeGenerator{width, height}.generate(); }},
+    };
+
+    std::cout << "Generating " << width << "x" << height << " mazes, best of " << repetitions << ":" << std::endl;
+    for (const auto &[name, generate]: generators) {
+        auto best = std::chrono::duration<double>::max();
+        for (auto i = 0; i < repetitions; ++i) {
+            const auto start = std::chrono::steady_clock::now();
+            const auto m = generate();
+            best = std::min(best, std::chrono::duration<double>{std::chrono::steady_clock::now() - start});
+        }
+        std::cout << '\t' << name << ": " << best.count() << "s" << std::endl;
+    }
+}
@@ -24,7 +24,8 @@ int main(int argc, char *argv[]) {
                   << "\t\t0: oldest cell first" << std::endl
                   << "\t\t1: newest cell first" << std::endl
                   << "\t\t2: middle cell first" << std::endl
-                  << "\t\t3: random cell first" << std::endl;
+                  << "\t\t3: random cell first" << std::endl
+                  << "\t\t4: newest cell first 75% of the time, random cell otherwise" << std::endl;
         return 1;
     }
 
@@ -41,29 +42,33 @@ int main(int argc, char *argv[]) {
     }
 
     const int strategy = Utils::parseLong(argv[3]);
-    if (strategy < 0 || strategy > 3) {
+    if (strategy < 0 || strategy > 4) {
         std::cerr << "Invalid strategy: " << argv[3] << std::endl;
         return 4;
     }
 
     // Retrieve the strategy.
-    spelunker::maze::GrowingTreeMazeGenerator::CellSelectionStrategy strategyType;
+    using CellSelectionStrategy = spelunker::maze::GrowingTreeMazeGenerator::CellSelectionStrategy;
+    spelunker::maze::GrowingTreeMazeGenerator::WeightedStrategies strategies;
     switch (strategy) {
         case 0:
-            strategyType = spelunker::maze::GrowingTreeMazeGenerator::CellSelectionStrategy::OLDEST;
+            strategies = {{CellSelectionStrategy::OLDEST, 1}};
             break;
         case 1:
-            strategyType = spelunker::maze::GrowingTreeMazeGenerator::CellSelectionStrategy::NEWEST;
+            strategies = {{CellSelectionStrategy::NEWEST, 1}};
             break;
         case 2:
-            strategyType = spelunker::maze::GrowingTreeMazeGenerator::CellSelectionStrategy::MIDDLE;
+            strategies = {{CellSelectionStrategy::MIDDLE, 1}};
+            break;
+        case 3:
+            strategies = {{CellSelectionStrategy::RANDOM, 1}};
             break;
         default:
-            strategyType = spelunker::maze::GrowingTreeMazeGenerator::CellSelectionStrategy::RANDOM;
+            strategies = {{CellSelectionStrategy::NEWEST, 0.75}, {CellSelectionStrategy::RANDOM, 0.25}};
             break;
     };
 
-    spelunker::maze::GrowingTreeMazeGenerator gen(width, height, strategyType);
+    spelunker::maze::GrowingTreeMazeGenerator gen(width, height, strategies);
     const spelunker::maze::Maze m = gen.generate();
     std::cout << spelunker::typeclasses::Show<spelunker::maze::Maze>::show(m);
     return 0;
@@ -0,0 +1,72 @@
+/**
+ * maze_world.cpp
+ *
+ * By Sebastian Raaphorst, 2018.
+ *
+ * Display a window onto an unbounded maze generated in chunks with the depth-first search.
+ * Because @see{MazeWorld} is not a @see{MazeGenerator}, we must implement without the use of @see{Executor}.
+ */
+
+#include <cstdint>
+#include <iostream>
+
+#include <typeclasses/Show.h>
+#include <types/Dimensions2D.h>
+#include <types/Direction.h>
+#include <maze/DFSMazeGenerator.h>
+#include <maze/Maze.h>
+#include <maze/MazeAttributes.h>
+#include <maze/MazeTypeclasses.h>
+#include <maze/MazeWorld.h>
+
+#include "Utils.h"
+
+int main(int argc, char *argv[]) {
+    if (argc != 6) {
+        std::cerr << "Usage: " << argv[0] << " seed x y width height" << std::endl
+                  << "\twhere (x,y) is the northwest cell of the window, which may be negative" << std::endl;
+        return 1;
+    }
+
+    const auto seed = static_cast<std::uint64_t>(Utils::parseLong(argv[1]));
+    const std::int64_t x0 = Utils::parseLong(argv[2]);
+    const std::int64_t y0 = Utils::parseLong(argv[3]);
+
+    const int width = Utils::parseLong(argv[4]);
+    if (width <= 0) {
+        std::cerr << "Invalid width: " << argv[4] << std::endl;
+        return 2;
+    }
+
+    const int height = Utils::parseLong(argv[5]);
+    if (height <= 0) {
+        std::cerr << "Invalid height: " << argv[5] << std::endl;
+        return 3;
+    }
+
+    using namespace spelunker;
+    maze::MazeWorld world{seed, types::Dimensions2D{16, 16}, maze::MazeWorld::factoryFor<maze::DFSMazeGenerator>()};
+
+    // Generate the chunks covering the window ahead of time.
+    const auto [cx0, cy0] = world.chunkOf(x0, y0);
+    const auto [cx1, cy1] = world.chunkOf(x0 + width - 1, y0 + height - 1);
+    for (auto cy = cy0; cy <= cy1; ++cy)
+        for (auto cx = cx0; cx <= cx1; ++cx)
+            world.prefetch(cx, cy, 0);
+
+    const types::Dimensions2D dim{width, height};
+    auto wi = maze::createMazeLayout(dim, true);
+    for (auto y = 0; y < height; ++y)
+        for (auto x = 0; x < width; ++x) {
+            if (x + 1 < width)
+                wi[maze::Maze::rankPositionS(dim, x, y, types::Direction::EAST)] =
+                        world.wall(x0 + x, y0 + y, types::Direction::EAST);
+            if (y + 1 < height)
+                wi[maze::Maze::rankPositionS(dim, x, y, types::Direction::SOUTH)] =
+                        world.wall(x0 + x, y0 + y, types::Direction::SOUTH);
+        }
+
+    const maze::Maze m{dim, wi};
+    std::cout << typeclasses::Show<maze::Maze>::show(m);
+    return 0;
+}
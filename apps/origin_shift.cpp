@@ -0,0 +1,15 @@
+/**
+ * origin_shift.cpp
+ *
+ * By Sebastian Raaphorst, 2018.
+ *
+ * Generate a maze by shifting the origin of a rooted spanning tree at random.
+ */
+
+#include <maze/OriginShiftMazeGenerator.h>
+
+#include "Executor.h"
+
+int main(int argc, char *argv[]) {
+    return Executor<spelunker::maze::OriginShiftMazeGenerator>::generateAndDisplayMaze(argc, argv);
+}
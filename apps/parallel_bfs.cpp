@@ -0,0 +1,15 @@
+/**
+ * parallel_bfs.cpp
+ *
+ * By Sebastian Raaphorst, 2018.
+ *
+ * Generate a maze with the distribution of a randomized breadth-first search, across multiple threads.
+ */
+
+#include <maze/ParallelBFSMazeGenerator.h>
+
+#include "Executor.h"
+
+int main(int argc, char *argv[]) {
+    return Executor<spelunker::maze::ParallelBFSMazeGenerator>::generateAndDisplayMaze(argc, argv);
+}
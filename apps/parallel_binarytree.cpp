@@ -0,0 +1,15 @@
+/**
+ * parallel_binarytree.cpp
+ *
+ * By Sebastian Raaphorst, 2018.
+ *
+ * Generate a maze using the binary tree approach on whole words of cells, across multiple threads.
+ */
+
+#include <maze/ParallelBinaryTreeMazeGenerator.h>
+
+#include "Executor.h"
+
+int main(int argc, char *argv[]) {
+    return Executor<spelunker::maze::ParallelBinaryTreeMazeGenerator>::generateAndDisplayMaze(argc, argv);
+}
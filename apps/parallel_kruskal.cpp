@@ -0,0 +1,15 @@
+/**
+ * parallel_kruskal.cpp
+ *
+ * By Sebastian Raaphorst, 2018.
+ *
+ * Generate a maze with the distribution of the randomized Kruskal algorithm using Borůvka's algorithm in parallel.
+ */
+
+#include <maze/ParallelKruskalMazeGenerator.h>
+
+#include "Executor.h"
+
+int main(int argc, char *argv[]) {
+    return Executor<spelunker::maze::ParallelKruskalMazeGenerator>::generateAndDisplayMaze(argc, argv);
+}
@@ -0,0 +1,15 @@
+/**
+ * parallel_recursive_division.cpp
+ *
+ * By Sebastian Raaphorst, 2018.
+ *
+ * Generate a maze using recursive division, dividing the subareas concurrently.
+ */
+
+#include <maze/ParallelRecursiveDivisionMazeGenerator.h>
+
+#include "Executor.h"
+
+int main(int argc, char *argv[]) {
+    return Executor<spelunker::maze::ParallelRecursiveDivisionMazeGenerator>::generateAndDisplayMaze(argc, argv);
+}
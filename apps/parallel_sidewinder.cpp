@@ -0,0 +1,15 @@
+/**
+ * parallel_sidewinder.cpp
+ *
+ * By Sebastian Raaphorst, 2018.
+ *
+ * Generate a maze using the sidewinder algorithm on whole words of cells, across multiple threads.
+ */
+
+#include <maze/ParallelSidewinderMazeGenerator.h>
+
+#include "Executor.h"
+
+int main(int argc, char *argv[]) {
+    return Executor<spelunker::maze::ParallelSidewinderMazeGenerator>::generateAndDisplayMaze(argc, argv);
+}
@@ -0,0 +1,15 @@
+/**
+ * propp_wilson.cpp
+ *
+ * By Sebastian Raaphorst, 2018.
+ *
+ * Generate a maze with the distribution of Wilson's algorithm using Propp and Wilson's cycle popping in parallel.
+ */
+
+#include <maze/ProppWilsonMazeGenerator.h>
+
+#include "Executor.h"
+
+int main(int argc, char *argv[]) {
+    return Executor<spelunker::maze::ProppWilsonMazeGenerator>::generateAndDisplayMaze(argc, argv);
+}
@@ -0,0 +1,67 @@
+/**
+ * tiled.cpp
+ *
+ * By Sebastian Raaphorst, 2018.
+ *
+ * Generate a maze as tiles stitched together, with the tiles alternating between the depth-first search and
+ * Wilson's algorithm in a checkerboard pattern.
+ * Because @see{TiledMazeGenerator} takes the tile size and the generators of the tiles, we must implement without
+ * the use of @see{Executor}.
+ */
+
+#include <iostream>
+#include <memory>
+
+#include <typeclasses/Show.h>
+#include <types/Dimensions2D.h>
+#include <maze/DFSMazeGenerator.h>
+#include <maze/Maze.h>
+#include <maze/MazeGenerator.h>
+#include <maze/MazeTypeclasses.h>
+#include <maze/TiledMazeGenerator.h>
+#include <maze/WilsonMazeGenerator.h>
+
+#include "Utils.h"
+
+int main(int argc, char *argv[]) {
+    if (argc != 5) {
+        std::cerr << "Usage: " << argv[0] << " width height tileWidth tileHeight" << std::endl;
+        return 1;
+    }
+
+    const int width = Utils::parseLong(argv[1]);
+    if (width <= 0) {
+        std::cerr << "Invalid width: " << argv[1] << std::endl;
+        return 2;
+    }
+
+    const int height = Utils::parseLong(argv[2]);
+    if (height <= 0) {
+        std::cerr << "Invalid height: " << argv[2] << std::endl;
+        return 3;
+    }
+
+    const int tileWidth = Utils::parseLong(argv[3]);
+    if (tileWidth <= 0) {
+        std::cerr << "Invalid tile width: " << argv[3] << std::endl;
+        return 4;
+    }
+
+    const int tileHeight = Utils::parseLong(argv[4]);
+    if (tileHeight <= 0) {
+        std::cerr << "Invalid tile height: " << argv[4] << std::endl;
+        return 5;
+    }
+
+    const auto checkerboard = [](const int column, const int row, const spelunker::types::Dimensions2D &d)
+            -> std::unique_ptr<spelunker::maze::MazeGenerator> {
+        if ((column + row) % 2 == 0)
+            return std::make_unique<spelunker::maze::DFSMazeGenerator>(d);
+        return std::make_unique<spelunker::maze::WilsonMazeGenerator>(d);
+    };
+
+    spelunker::maze::TiledMazeGenerator gen(width, height, tileWidth, tileHeight, checkerboard);
+    const spelunker::maze::Maze m = gen.generate();
+    std::cout << spelunker::typeclasses::Show<spelunker::maze::Maze>::show(m);
+    return 0;
+}
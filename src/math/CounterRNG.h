@@ -0,0 +1,102 @@
+/**
+ * CounterRNG.h
+ *
+ * By Sebastian Raaphorst, 2018.
+ *
+ * A counter-based random number generator, for generating random values from multiple threads.
+ */
+
+#pragma once
+
+#include <climits>
+#include <cstdint>
+
+#include "RNG.h"
+
+namespace spelunker::math {
+    /// The splitmix64 finalizer: a fast bijection on 64-bit integers with good avalanche behaviour.
+    constexpr std::uint64_t mix64(std::uint64_t x) noexcept {
+        x = (x ^ (x >> 30u)) * 0xbf58476d1ce4e5b9ull;
+        x = (x ^ (x >> 27u)) * 0x94d049bb133111ebull;
+        return x ^ (x >> 31u);
+    }
+
+    /**
+     * A counter-based random number generator.
+     *
+     * Instead of producing a sequence of values from an internal state, as @see{RNG} does, the value for a counter
+     * is a hash of the counter and the seed. Since there is no state, values can be computed in any order and from
+     * any number of threads, and the results depend only upon the seed: e.g. a parallel algorithm that draws the
+     * value for wall w from counter w produces the same maze regardless of the number of threads used.
+     */
+    class CounterRNG final {
+    public:
+        explicit constexpr CounterRNG(const std::uint64_t s) noexcept : seed{s} {}
+
+        /// Create a generator seeded from @see{RNG}, so that mazes remain reproducible when the RNG is.
+        static CounterRNG fromRNG() {
+            const auto draw = [] { return static_cast<std::uint64_t>(RNG::randomRange(INT_MAX)); };
+            const auto hi = draw();
+            const auto mid = draw();
+            const auto lo = draw();
+            return CounterRNG{(hi << 33u) ^ (mid << 16u) ^ lo};
+        }
+
+        /// The random 64-bit value for a counter.
+        constexpr std::uint64_t operator()(const std::uint64_t counter) const noexcept {
+            return mix64(seed ^ mix64(counter + 0x9e3779b97f4a7c15ull));
+        }
+
+        /// The random 64-bit value for a counter within an independent stream, e.g. one stream per row.
+        constexpr std::uint64_t operator()(const std::uint64_t stream, const std::uint64_t counter) const noexcept {
+            return (*this)(mix64(stream ^ 0x632be59bd9b4e019ull) + counter);
+        }
+
+        /// A random value for a counter in the range [0,upper), for upper > 0.
+        constexpr int range(const std::uint64_t counter, const int upper) const noexcept {
+            return static_cast<int>(((*this)(counter) >> 32u) * static_cast<std::uint64_t>(upper) >> 32u);
+        }
+
+        /// A random value for a counter within a stream in the range [0,upper), for upper > 0.
+        constexpr int range(const std::uint64_t stream, const std::uint64_t counter, const int upper) const noexcept {
+            return static_cast<int>(((*this)(stream, counter) >> 32u) * static_cast<std::uint64_t>(upper) >> 32u);
+        }
+
+        /**
+         * A random 64-bit word in which each bit is set independently with probability p, to a precision of 2^-32.
+         * The word is built from up to 32 values of the stream, from counters 32 * counter onwards.
+         */
+        constexpr std::uint64_t bernoulliWord(const std::uint64_t stream, const std::uint64_t counter,
+                                              const double p) const noexcept {
+            // Combine random words by the binary expansion of p from its least significant bit: or-ing in a random
+            // word for a one bit maps a bit probability q to (1+q)/2, and and-ing one in for a zero maps it to q/2.
+            const auto fixed = static_cast<std::uint64_t>(p * 4294967296.0 + 0.5);
+            if (fixed == 0)
+                return 0;
+            if (fixed >> 32u)
+                return ~std::uint64_t{0};
+
+            auto bit = 0u;
+            while (!((fixed >> bit) & 1u))
+                ++bit;
+            std::uint64_t word = 0;
+            for (; bit < 32; ++bit) {
+                const auto r = (*this)(stream, 32 * counter + bit);
+                word = ((fixed >> bit) & 1u) ? (word | r) : (word & r);
+            }
+            return word;
+        }
+
+        /// A random value for a counter in the range [0,1).
+        constexpr double probability(const std::uint64_t counter) const noexcept {
+            return static_cast<double>((*this)(counter) >> 11u) * (1.0 / 9007199254740992.0);
+        }
+
+        constexpr std::uint64_t getSeed() const noexcept {
+            return seed;
+        }
+
+    private:
+        const std::uint64_t seed;
+    };
+}
@@ -4,13 +4,20 @@
  * By Sebastian Raaphorst, 2018.
  */
 
+#include <cstdint>
 #include <random>
 
 #include "DefaultRNG.h"
 
 namespace spelunker::math {
     DefaultRNG::DefaultRNG()
-        : rd(), g(rd()) {}
+        : g(std::random_device{}()) {}
+
+    DefaultRNG::DefaultRNG(const std::uint64_t seed) {
+        // Use all 64 bits of the seed.
+        std::seed_seq seq{static_cast<std::uint32_t>(seed), static_cast<std::uint32_t>(seed >> 32u)};
+        g.seed(seq);
+    }
 
     int DefaultRNG::randomRangeImpl(int lower, int upper) noexcept {
         std::uniform_int_distribution<> dist(lower, upper-1);
@@ -8,6 +8,7 @@
 
 #pragma once
 
+#include <cstdint>
 #include <random>
 
 #include "RNG.h"
@@ -18,10 +19,12 @@ namespace spelunker::math {
      * The default random number generator, using STL's implementation of the Mersenne twister.
      * If no other RNG is set, this is used by default when accessing the RNG class.
      * No action is required on the part of the user to initialize it.
+     * It may also be seeded explicitly, e.g. to give each thread a reproducible stream of its own.
      */
     class DefaultRNG final : public RNG {
     public:
         DefaultRNG();
+        explicit DefaultRNG(std::uint64_t seed);
         ~DefaultRNG() final = default;
 
     protected:
@@ -30,7 +33,6 @@ namespace spelunker::math {
         double randomProbabilityImpl() noexcept final;
 
     private:
-        std::random_device rd;
         std::mt19937 g;
     };
 };
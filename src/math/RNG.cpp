@@ -16,16 +16,26 @@
 namespace spelunker::math {
     std::shared_ptr<RNG> RNG::rng = nullptr;
 
-    RNG::~RNG() {
-        rng.reset();
+    namespace {
+        /// The RNG of the calling thread, if one has been set.
+        thread_local std::shared_ptr<RNG> threadRNG = nullptr;
     }
 
+    RNG::~RNG() = default;
+
     void RNG::setRNG(std::shared_ptr<RNG> &nRNG) noexcept {
         if (rng) rng.reset();
         rng = nRNG;
     }
 
+    std::shared_ptr<RNG> RNG::setThreadRNG(std::shared_ptr<RNG> nRNG) noexcept {
+        threadRNG.swap(nRNG);
+        return nRNG;
+    }
+
     std::shared_ptr<RNG> RNG::getRNG() noexcept {
+        if (threadRNG)
+            return threadRNG;
         if (!rng) {
             rng = std::make_shared<DefaultRNG>();
         }
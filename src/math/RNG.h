@@ -9,6 +9,7 @@
 #include <algorithm>
 #include <memory>
 #include <stdexcept>
+#include <utility>
 
 #pragma once
 
@@ -26,6 +27,33 @@ namespace spelunker::math {
         static void setRNG(std::shared_ptr<RNG> &nRNG) noexcept;
         static std::shared_ptr<RNG> getRNG() noexcept;
 
+        /// Set the RNG used by the calling thread.
+        /**
+         * Set the RNG used by the calling thread only, which takes precedence over the one set by @see{setRNG}.
+         * RNGs are not thread-safe, so each thread generating random numbers concurrently needs one of its own.
+         * @param nRNG the RNG for the thread, or nullptr to revert to the shared RNG
+         * @return the RNG previously set for the thread, if any, so that it can be restored
+         */
+        static std::shared_ptr<RNG> setThreadRNG(std::shared_ptr<RNG> nRNG) noexcept;
+
+        /// Set the RNG used by the calling thread for the lifetime of the scope.
+        /**
+         * Set the RNG used by the calling thread, as @see{setThreadRNG} does, and restore the previous one when the
+         * scope ends, even if it ends with an exception.
+         */
+        class ThreadRNGScope final {
+        public:
+            explicit ThreadRNGScope(std::shared_ptr<RNG> nRNG) noexcept
+                : previous{setThreadRNG(std::move(nRNG))} {}
+            ~ThreadRNGScope() { setThreadRNG(std::move(previous)); }
+
+            ThreadRNGScope(const ThreadRNGScope&) = delete;
+            ThreadRNGScope &operator=(const ThreadRNGScope&) = delete;
+
+        private:
+            std::shared_ptr<RNG> previous;
+        };
+
         /// Generate a number in the range [lower,upper).
         /**
          * Given a value upper, returns a random number in the range [lower,upper).
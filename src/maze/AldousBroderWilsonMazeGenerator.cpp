@@ -0,0 +1,102 @@
+/**
+ * AldousBroderWilsonMazeGenerator.cpp
+ *
+ * By Sebastian Raaphorst, 2018.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include <types/CommonMazeAttributes.h>
+#include <types/Dimensions2D.h>
+#include <types/Direction.h>
+#include <math/MathUtils.h>
+#include <math/RNG.h>
+
+#include "Maze.h"
+#include "MazeAttributes.h"
+#include "MazeGenerator.h"
+#include "AldousBroderWilsonMazeGenerator.h"
+
+namespace spelunker::maze {
+    AldousBroderWilsonMazeGenerator::AldousBroderWilsonMazeGenerator(const types::Dimensions2D &d,
+                                                                     const double switchOver)
+        : MazeGenerator{d}, switchOver{switchOver} {
+        math::MathUtils::checkProbability(switchOver);
+    }
+
+    AldousBroderWilsonMazeGenerator::AldousBroderWilsonMazeGenerator(const int w, const int h, const double switchOver)
+        : AldousBroderWilsonMazeGenerator{types::Dimensions2D{w, h}, switchOver} {}
+
+    AldousBroderWilsonMazeGenerator::AldousBroderWilsonMazeGenerator(const types::Dimensions2D &d)
+        : AldousBroderWilsonMazeGenerator{d, defaultSwitchOver} {}
+
+    AldousBroderWilsonMazeGenerator::AldousBroderWilsonMazeGenerator(const int w, const int h)
+        : AldousBroderWilsonMazeGenerator{types::Dimensions2D{w, h}, defaultSwitchOver} {}
+
+    const Maze AldousBroderWilsonMazeGenerator::generate() const noexcept {
+        const auto [width, height] = getDimensions().values();
+        const auto numCells = width * height;
+
+        // We start with all walls, and remove them iteratively.
+        auto wi = createMazeLayout(getDimensions(), true);
+
+        // The cells in the maze, by rank.
+        std::vector<char> visited(numCells, false);
+
+        const auto carve = [this, &wi](const int x, const int y, const types::Direction d) {
+            wi[rankPos(types::pos(x, y, d))] = false;
+        };
+
+        // Aldous-Broder: wander from a random cell, carving into every cell not yet in the maze, until we have
+        // visited enough of them. We always visit at least one cell, so that Wilson's algorithm has a maze to reach.
+        auto x = math::RNG::randomRange(width);
+        auto y = math::RNG::randomRange(height);
+        visited[rankCell(x, y)] = true;
+
+        const auto abCells = std::max(1, static_cast<int>(std::ceil(switchOver * numCells)));
+        for (auto numVisited = 1; numVisited < abCells;) {
+            types::Direction dirs[4];
+            const auto dir = dirs[math::RNG::randomRange(neighbourDirections(x, y, dirs))];
+            const auto [nx, ny] = types::applyDirectionToCell(types::cell(x, y), dir);
+
+            const auto rk = rankCell(nx, ny);
+            if (!visited[rk]) {
+                visited[rk] = true;
+                carve(x, y, dir);
+                ++numVisited;
+            }
+            x = nx;
+            y = ny;
+        }
+
+        // Wilson: from every cell not in the maze, take a random walk until we reach the maze, recording the direction
+        // in which we last left each cell, and carve the loop-erased walk by following those directions.
+        std::vector<types::Direction> exits(numCells, types::Direction::NORTH);
+        for (auto start = 0; start < numCells; ++start) {
+            if (visited[start])
+                continue;
+
+            auto rk = start;
+            while (!visited[rk]) {
+                types::Direction dirs[4];
+                const auto [cx, cy] = unrankCell(rk);
+                const auto dir = dirs[math::RNG::randomRange(neighbourDirections(cx, cy, dirs))];
+                exits[rk] = dir;
+                const auto [nx, ny] = types::applyDirectionToCell(types::cell(cx, cy), dir);
+                rk = rankCell(nx, ny);
+            }
+
+            for (rk = start; !visited[rk];) {
+                visited[rk] = true;
+                const auto [cx, cy] = unrankCell(rk);
+                carve(cx, cy, exits[rk]);
+                const auto [nx, ny] = types::applyDirectionToCell(types::cell(cx, cy), exits[rk]);
+                rk = rankCell(nx, ny);
+            }
+        }
+
+        return Maze(getDimensions(), wi);
+    }
+}
@@ -0,0 +1,53 @@
+/**
+ * AldousBroderWilsonMazeGenerator.h
+ *
+ * By Sebastian Raaphorst, 2018.
+ *
+ * A maze generator producing uniform spanning trees by starting with the
+ * <a href="http://weblog.jamisbuck.org/2011/1/17/maze-generation-aldous-broder-algorithm">Aldous-Broder algorithm</a>
+ * and finishing with <a href="http://weblog.jamisbuck.org/2011/1/20/maze-generation-wilson-s-algorithm.html">
+ * Wilson's algorithm</a>.
+ */
+
+#pragma once
+
+#include <types/Dimensions2D.h>
+
+#include "MazeGenerator.h"
+
+namespace spelunker::maze {
+    class Maze;
+
+    /**
+     * Aldous-Broder and Wilson's algorithm both find uniform spanning trees, but they are slow at opposite ends:
+     * Aldous-Broder carves quickly at first, but near the end of its cover time, it wanders over visited cells for
+     * almost all of its steps; Wilson's algorithm wanders for a long time before its first walks reach the tiny
+     * initial maze, but then finishes quickly.
+     *
+     * This generator runs Aldous-Broder until the given fraction of the cells have been visited, and then completes
+     * the maze with Wilson's loop-erased random walks from the remaining cells, using the cells visited so far as
+     * the initial maze. The result is still a uniform spanning tree.
+     */
+    class AldousBroderWilsonMazeGenerator final : public MazeGenerator {
+    public:
+        /**
+         * Create a generator that switches from Aldous-Broder to Wilson's algorithm after the fraction switchOver of
+         * the cells have been visited: 0 is pure Wilson's algorithm, and 1 is pure Aldous-Broder.
+         * @param d dimensions of the maze
+         * @param switchOver the fraction of cells to visit using Aldous-Broder
+         */
+        AldousBroderWilsonMazeGenerator(const types::Dimensions2D &d, double switchOver);
+        AldousBroderWilsonMazeGenerator(int w, int h, double switchOver);
+        AldousBroderWilsonMazeGenerator(const types::Dimensions2D &d);
+        AldousBroderWilsonMazeGenerator(int w, int h);
+
+        ~AldousBroderWilsonMazeGenerator() final = default;
+
+        const Maze generate() const noexcept final;
+
+        static constexpr double defaultSwitchOver = 0.5;
+
+    private:
+        const double switchOver;
+    };
+}
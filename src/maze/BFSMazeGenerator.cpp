@@ -5,8 +5,10 @@
  */
 
 #include <queue>
+#include <vector>
 
 #include <types/CommonMazeAttributes.h>
+#include <types/Direction.h>
 #include <math/RNG.h>
 
 #include "Maze.h"
@@ -27,40 +29,54 @@ namespace spelunker::maze {
         // We start with all walls, and remove them iteratively.
         auto wi = createMazeLayout(getDimensions(), true);
 
-        // We need a cell lookup to check if we have visited a cell already.
-        auto ci = types::initializeCellIndicator(getDimensions(), false);
+        // Cells are visited once they are in the maze, and queued once they have been pushed to the queue, so that
+        // no cell is pushed twice.
+        std::vector<char> visited(width * height, false);
+        std::vector<char> queued(width * height, false);
+        std::queue<int> queue;
+
+        // Push the unvisited neighbours of a cell to the back of the queue.
+        const auto pushNeighbours = [&](const int x, const int y) {
+            types::Direction dirs[4];
+            const auto numDirs = neighbourDirections(x, y, dirs);
+            for (auto i = 0; i < numDirs; ++i) {
+                const auto [nx, ny] = types::applyDirectionToCell(types::cell(x, y), dirs[i]);
+                const auto rk = rankCell(nx, ny);
+                if (!visited[rk] && !queued[rk]) {
+                    queued[rk] = true;
+                    queue.emplace(rk);
+                }
+            }
+        };
 
         // Pick a random starting cell, mark it, and add its neighbours to a queue.
         const auto startX = math::RNG::randomRange(width);
         const auto startY = math::RNG::randomRange(height);
-        ci[startX][startY] = true;
-
-        std::queue<types::Cell> queue;
-        const auto startNbrs = unvisitedNeighbours(types::cell(startX, startY), ci);
-        for (auto startNbr : startNbrs)
-            queue.emplace(startNbr.first);
+        visited[rankCell(startX, startY)] = true;
+        pushNeighbours(startX, startY);
 
         while (!queue.empty()) {
-            // Pick the front cell from the queue. If it has somehow been visited,
-            // then skip it.
-            const auto cell = queue.front();
+            // Pick the front cell from the queue.
+            const auto rk = queue.front();
             queue.pop();
+            const auto [x, y] = unrankCell(rk);
 
-            const auto [cellx, celly] = cell;
-            if (ci[cellx][celly]) continue;
-
-            // Otherwise, find its visited neighbours in the maze and pick one at random.
-            const auto vnbrs = visitedNeighbours(cell, ci);
-            const auto vnbr  = math::RNG::randomElement(vnbrs);
-            wi[rankPos(vnbr)] = false;
-            ci[cellx][celly] = true;
+            // Find its visited neighbours in the maze and pick one at random.
+            types::Direction dirs[4];
+            const auto numAll = neighbourDirections(x, y, dirs);
+            auto numDirs = 0;
+            for (auto i = 0; i < numAll; ++i) {
+                const auto [nx, ny] = types::applyDirectionToCell(types::cell(x, y), dirs[i]);
+                if (visited[rankCell(nx, ny)])
+                    dirs[numDirs++] = dirs[i];
+            }
+            wi[rankPos(types::pos(x, y, dirs[math::RNG::randomRange(numDirs)]))] = false;
+            visited[rk] = true;
 
             // Add the unvisited neighbours to the queue.
-            const auto unbrs = unvisitedNeighbours(cell, ci);
-            for (auto unbr : unbrs)
-                queue.emplace(unbr.first);
+            pushNeighbours(x, y);
         }
 
         return Maze(getDimensions(), wi);
     }
-}
\ No newline at end of file
+}
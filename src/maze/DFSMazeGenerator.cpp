@@ -4,11 +4,15 @@
  * By Sebastian Raaphorst, 2018.
  */
 
-#include <stack>
+#include <cstdint>
+#include <memory>
+#include <tuple>
 #include <vector>
 
+#include <types/BitUtils.h>
 #include <types/CommonMazeAttributes.h>
 #include <types/Dimensions2D.h>
+#include <types/Direction.h>
 #include <math/RNG.h>
 
 #include "Maze.h"
@@ -23,39 +27,111 @@ namespace spelunker::maze {
     DFSMazeGenerator::DFSMazeGenerator(int w, int h)
         : MazeGenerator{types::Dimensions2D{w, h}} {}
 
-    const Maze DFSMazeGenerator::generate() const noexcept {
-        const auto [width, height] = getDimensions().values();
+    class DFSMazeGenerator::Stepper final : public MazeStepper {
+    public:
+        explicit Stepper(const DFSMazeGenerator &g)
+            : MazeStepper{g.getDimensions()},
+              gen{g},
+              wi(createMazeLayout(g.getDimensions(), true)),
+              visited(types::numWords(numCells(g)), 0),
+              backtrack(types::numWords(2 * numCells(g)), 0) {
+            // Pick a starting cell.
+            x = math::RNG::randomRange(g.getWidth());
+            y = math::RNG::randomRange(g.getHeight());
+            startRk = gen.rankCell(x, y);
+            types::setBit(visited.data(), startRk);
+        }
 
-        // We start with all walls, and then remove them iteratively.
-        auto wi = createMazeLayout(getDimensions(), true);
-
-        // We need a cell lookup to check if we have visited a cell already.
-        auto ci = types::initializeCellIndicator(getDimensions(), false);
-
-        // Create the stack and pick a starting cell.
-        std::stack<types::Cell> stack;
-        stack.push(types::cell(math::RNG::randomRange(width), math::RNG::randomRange(height)));
-
-        while (!stack.empty()) {
-            // Marking c visited will occur multiple times, but we don't care.
-            const auto c = stack.top();
-            const auto [cx, cy] = c;
-            ci[cx][cy] = true;
-
-            // Find a list of unvisited neighbours. If we can't find one, then backtrack.
-            const auto nbrs = unvisitedNeighbours(c, ci);
-            if (nbrs.empty()) {
-                stack.pop();
-                continue;
+        bool isDone() const noexcept final {
+            return done;
+        }
+
+        const Maze current() const final {
+            return Maze(getDimensions(), wi);
+        }
+
+    protected:
+        std::uint64_t run(const std::uint64_t maxSteps) final {
+            const auto [width, height] = getDimensions().values();
+
+            // The directions in the order in which neighbours have always been considered, so that the mazes
+            // generated are unchanged: bit i of the mask of unvisited neighbours corresponds to order[i].
+            constexpr types::Direction order[] = {types::Direction::WEST, types::Direction::NORTH,
+                                                  types::Direction::EAST, types::Direction::SOUTH};
+
+            std::uint64_t steps = 0;
+            for (; steps < maxSteps; ++steps) {
+                // Find the mask of unvisited neighbours.
+                const auto rk = gen.rankCell(x, y);
+                unsigned int mask = 0;
+                if (x > 0          && !types::testBit(visited.data(), rk - 1))     mask |= 1u;
+                if (y > 0          && !types::testBit(visited.data(), rk - width)) mask |= 2u;
+                if (x < width - 1  && !types::testBit(visited.data(), rk + 1))     mask |= 4u;
+                if (y < height - 1 && !types::testBit(visited.data(), rk + width)) mask |= 8u;
+
+                // If there are none, then backtrack, finishing when we are back at the start.
+                if (mask == 0) {
+                    if (rk == startRk) {
+                        done = true;
+                        break;
+                    }
+                    std::tie(x, y) = types::applyDirectionToCell(types::cell(x, y), backtrackDirection(rk));
+                    continue;
+                }
+
+                // Pick an unvisited neighbour with a single draw, remove the wall to it, and move to it.
+                for (auto k = math::RNG::randomRange(types::popCount(mask)); k > 0; --k)
+                    mask &= mask - 1;
+                const auto dir = order[types::countTrailingZeros(mask)];
+                wi[gen.rankPos(types::pos(x, y, dir))] = false;
+                std::tie(x, y) = types::applyDirectionToCell(types::cell(x, y), dir);
+
+                const auto nbrRk = gen.rankCell(x, y);
+                types::setBit(visited.data(), nbrRk);
+                setBacktrackDirection(nbrRk, types::flip(dir));
             }
+            return steps;
+        }
 
-            // Pick an unvisited neighbour, remove the wall to it, and move to it by pushing it on the stack.
-            const auto nbr = math::RNG::randomElement(nbrs);
-            const auto w = rankPos(nbr);
-            wi[w] = false;
-            stack.push(nbr.first);
+    private:
+        static inline std::uint64_t numCells(const DFSMazeGenerator &g) noexcept {
+            return static_cast<std::uint64_t>(g.getWidth()) * g.getHeight();
         }
 
-        return Maze(getDimensions(), wi);
+        inline types::Direction backtrackDirection(const int rk) const noexcept {
+            const auto bit = 2 * static_cast<std::uint64_t>(rk);
+            return static_cast<types::Direction>((backtrack[bit / types::WordBits] >> (bit % types::WordBits)) & 3u);
+        }
+
+        inline void setBacktrackDirection(const int rk, const types::Direction d) noexcept {
+            const auto bit = 2 * static_cast<std::uint64_t>(rk);
+            backtrack[bit / types::WordBits] |= static_cast<std::uint64_t>(d) << (bit % types::WordBits);
+        }
+
+        const DFSMazeGenerator gen;
+
+        // We start with all walls, and then remove them iteratively.
+        WallIncidence wi;
+
+        // A bitmap of the visited cells, and for each visited cell but the start, the 2-bit direction back to the
+        // cell from which it was reached. The latter replaces the stack: backtracking follows the directions.
+        std::vector<std::uint64_t> visited;
+        std::vector<std::uint64_t> backtrack;
+
+        // The current cell and the starting cell.
+        int x;
+        int y;
+        int startRk;
+        bool done = false;
+    };
+
+    const Maze DFSMazeGenerator::generate() const noexcept {
+        Stepper stepper{*this};
+        stepper.finish();
+        return stepper.current();
+    }
+
+    std::unique_ptr<MazeStepper> DFSMazeGenerator::stepper() const {
+        return std::make_unique<Stepper>(*this);
     }
-}
\ No newline at end of file
+}
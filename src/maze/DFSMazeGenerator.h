@@ -10,6 +10,8 @@
 
 #pragma once
 
+#include <memory>
+
 #include <types/Dimensions2D.h>
 
 #include "MazeAttributes.h"
@@ -26,7 +28,10 @@ namespace spelunker::maze {
      * long as possible until no longer able to do so. It then backtracks to the last visited cell with unvisited
      * neighbours, and begins carving passages at random to unvisited neighbours again.
      *
-     * In order to avoid stack overflows, we simulate recursion using a stack.
+     * In order to avoid stack overflows, we simulate recursion. Rather than keeping an explicit stack, each cell
+     * records the direction back to the cell from which it was carved in two bits, and backtracking follows these
+     * directions. Together with a visited bitmap, this needs three bits per cell beyond the maze itself. Note that
+     * since a @see{WallID} is an int, a @see{Maze} has fewer than 2^31 walls, and hence at most about 2^30 cells.
      *
      * This results in mazes with very long, windy passages, wherein it is difficult to find the end position,
      * but easier to begin at the end and find the starting position.
@@ -38,6 +43,15 @@ namespace spelunker::maze {
         ~DFSMazeGenerator() final = default;
 
         const Maze generate() const noexcept final;
+
+        /**
+         * Begin a generation that can be advanced a bounded number of steps at a time, which produces the same
+         * mazes as @see{generate}. A step is a move to an unvisited neighbour or a backtrack.
+         */
+        std::unique_ptr<MazeStepper> stepper() const;
+
+    private:
+        class Stepper;
     };
 };
 
@@ -4,14 +4,17 @@
  * By Sebastian Raaphorst, 2018.
  */
 
+#include <algorithm>
 #include <cmath>
+#include <ostream>
+#include <string>
 #include <vector>
-#include <boost/pending/disjoint_sets.hpp>
 
 #include <types/CommonMazeAttributes.h>
 #include <types/Dimensions2D.h>
 #include <types/Direction.h>
-#include <types/DisjointSetHelper.h>
+#include <types/DisjointSets.h>
+#include <types/Exceptions.h>
 #include <math/MathUtils.h>
 #include <math/RNG.h>
 
@@ -21,8 +24,6 @@
 #include "EllerMazeGenerator.h"
 
 namespace spelunker::maze {
-    using namespace boost;
-
     EllerMazeGenerator::EllerMazeGenerator(const types::Dimensions2D &d, const double p, const double den)
         : MazeGenerator{d}, probability{p}, density{den} {
         math::MathUtils::checkProbability(p);
@@ -38,108 +39,131 @@ namespace spelunker::maze {
     EllerMazeGenerator::EllerMazeGenerator(int w, int h)
         : EllerMazeGenerator{w, h, defaultProbability, defaultDensity} {}
 
-    const Maze EllerMazeGenerator::generate() const noexcept {
-        const auto [width, height] = getDimensions().values();
-
-        // We start with all walls, and then remove them iteratively.
-        auto wi = createMazeLayout(getDimensions(), true);
+    EllerRowStream::EllerRowStream(const int width, const double p, const double den)
+        : width{width}, probability{p}, density{den}, y{0} {
+        math::MathUtils::checkProbability(p);
+        math::MathUtils::checkProbability(den);
+        if (width < 1)
+            throw types::IllegalDimensions(width, 1);
 
-        // Create a vector of all elements.
-        std::vector<types::Element> elements;
-        elements.reserve(width * height);
+        // Every cell of the first row starts in its own set.
+        labels.resize(width);
         for (auto x = 0; x < width; ++x)
-            for (auto y = 0; y < height; ++y)
-                elements.emplace_back(types::Element(rankCell(x, y)));
-
-        for (auto i = 0; i < elements.size(); ++i)
-            elements[i].dsID = i;
-
-        // Create disjoint singleton sets.
-        types::Rank rank(elements);
-        types::Parent parent(elements);
-        boost::disjoint_sets<types::Rank *, types::Parent *> dsets(&rank, &parent);
-        for (auto &e: elements)
-            dsets.make_set(e);
-
-        for (int i = 0; i < width; ++i)
-            for (int j = 0; j < width; ++j) {
-                const auto m = rankCell(i, j);
-                const auto n = unrankCell(m);
-                assert(n.first == i);
-                assert(n.second == j);
+            labels[x] = x;
+    }
+
+    const EllerRow EllerRowStream::nextRow(const bool last) {
+        EllerRow row{y, std::vector<bool>(width - 1, true), std::vector<bool>(width, true)};
+
+        // The sets of the cells of this row, by label.
+        types::DisjointSets dsets(width);
+
+        for (auto x = 0; x < width - 1; ++x) {
+            // Check to see if (x,y) and (x+1,y) are in the same set.
+            // If not, connect them with the given probability, or, in
+            // the case of the last row, connect them anyway.
+            const auto l1 = labels[x];
+            const auto l2 = labels[x + 1];
+
+            if (!dsets.connected(l1, l2) && (last || math::RNG::randomProbability() < probability)) {
+                row.eastWalls[x] = false;
+                dsets.unite(l1, l2);
             }
-        const auto wMax = width - 1;
-        for (auto y = 0; y < height; ++y) {
-            for (auto x = 0; x < wMax; ++x) {
-                // Check to see if (x,y) and (x+1,y) are in the same set.
-                // If not, connect them with the given probability, or, in
-                // the case of the last row, connect them anyway.
-                const auto &set1 = dsets.find_set(elements[rankCell(x, y)]);
-                const auto &set2 = dsets.find_set(elements[rankCell(x + 1, y)]);
-
-                if (set1 != set2 && (y == height - 1 || math::RNG::randomProbability() < probability)) {
-                    wi[rankPos(types::pos(x, y, types::Direction::EAST))] = false;
-                    dsets.link(set1, set2);
-                }
+        }
+
+        ++y;
+        if (last)
+            return row;
+
+        // We find the partitioning and create at least one down wall per partition.
+        // The idea here is to iterate over the row, collecting up the cells that are connected.
+        // We then remove south-facing walls: at least one for each connected set, and the cells
+        // below them join the set. The cells labelled -1 in the next row are in new sets.
+        std::vector<int> nextLabels(width, -1);
+        auto curRep = dsets.find(labels[0]);
+        std::vector<int> cells;
+        cells.emplace_back(0);
+
+        // This is a bit hacky: we go until width, so that we process the last run of cells.
+        for (auto x = 1; x <= width; ++x) {
+            // If this cell has the same representative as the previous, add it to the vector
+            // and continue if we are not at the end of the row.
+            const auto nRep = x < width ? dsets.find(labels[x]) : -1;
+            if (x < width && nRep == curRep) {
+                cells.emplace_back(x);
+                continue;
             }
 
-            // If we are not at the bottom row, we find the partitioning and create at least one down wall per partition.
-            // The idea here is to iterate over the row, collecting up the cells that are connected.
-            // We then remove south-facing walls: at least one for each connected set.
-            if (y != height - 1) {
-                const auto firstRk = rankCell(0, y);
-                auto curRep = dsets.find_set(elements[firstRk]);
-                std::vector<int> cells;
-                cells.emplace_back(firstRk);
-
-                // This is a bit hacky: we go until width, so that we process the last cell if
-                // it isn't connected to the previous cells in the row, since it would have
-                // been added to freshly cleared cells in the previous iteration.
-                for (auto x = 1; x <= width; ++x) {
-                    // If this cell has the same representative as the previous, add it to the vector
-                    // and continue if we are not at the end of the row.
-                    // Since we go until width, we have to deal with the case that x == width.
-                    // We just hackishly take the rank of the previous cell to get something valid
-                    // in nRep for the set we're looking at.
-                    const auto rk = rankCell(x < width ? x : x - 1, y);
-                    const auto nRep = dsets.find_set(elements[rk]);
-
-                    if (x < width && nRep == curRep) {
-                        cells.emplace_back(rk);
-                        continue;
-                    }
-
-                    // Otherwise, we process the set, removing vertical walls as per the density.
-                    const auto maxNumGaps = std::max(1, (int) (density * cells.size()));
-                    auto numGapsToMake = math::RNG::randomRange(maxNumGaps) + 1;
-
-                    // Select that many cells and remove their south walls.
-                    while (numGapsToMake > 0) {
-                        const auto idx = math::RNG::randomRange(cells.size());
-                        std::swap(cells[idx], cells.back());
-                        const auto sRk = cells.back();
-                        cells.pop_back();
-
-                        const auto cell = unrankCell(sRk);
-                        wi[rankPos(types::pos(cell.first, cell.second, types::Direction::SOUTH))] = false;
-
-                        // Add the cell to this set in the partition.
-                        const auto &setDown = dsets.find_set(elements[rankCell(cell.first, cell.second + 1)]);
-                        dsets.link(curRep, setDown);
-                        --numGapsToMake;
-                    }
-
-                    // Now update the data structures.
-                    // We start a fresh partition. If we are at the end and the last cell in the
-                    // row was connected to the previous cell, the algorithm will terminate after
-                    // this, so emplacing rk does nothing it shouldn't.
-                    curRep = nRep;
-                    cells.clear();
-                    cells.emplace_back(rk);
-                }
+            // Otherwise, we process the set, removing vertical walls as per the density.
+            const auto maxNumGaps = std::max(1, (int) (density * cells.size()));
+            auto numGapsToMake = math::RNG::randomRange(maxNumGaps) + 1;
+
+            // Select that many cells and remove their south walls.
+            while (numGapsToMake > 0) {
+                const auto idx = math::RNG::randomRange(cells.size());
+                std::swap(cells[idx], cells.back());
+                const auto sx = cells.back();
+                cells.pop_back();
+
+                row.southWalls[sx] = false;
+                nextLabels[sx] = curRep;
+                --numGapsToMake;
             }
+
+            // We start a fresh partition.
+            curRep = nRep;
+            cells.clear();
+            cells.emplace_back(x);
         }
 
+        // Relabel the sets of the next row compactly, giving new labels to the cells in new sets.
+        std::vector<int> relabel(2 * width, -1);
+        auto numLabels = 0;
+        for (auto x = 0; x < width; ++x) {
+            const auto l = nextLabels[x] == -1 ? width + x : nextLabels[x];
+            if (relabel[l] == -1)
+                relabel[l] = numLabels++;
+            labels[x] = relabel[l];
+        }
+
+        return row;
+    }
+
+    EllerRowStream EllerMazeGenerator::rowStream() const {
+        return EllerRowStream{getWidth(), probability, density};
+    }
+
+    void EllerMazeGenerator::generateRows(const int numRows, const RowSink &sink) const {
+        auto stream = rowStream();
+        for (auto y = 0; y < numRows; ++y)
+            sink(stream.nextRow(y == numRows - 1));
+    }
+
+    void EllerMazeGenerator::generateRows(const int numRows, std::ostream &out) const {
+        generateRows(numRows, [&out](const EllerRow &row) { writeRow(out, row); });
+    }
+
+    void EllerMazeGenerator::writeRow(std::ostream &out, const EllerRow &row) {
+        const auto width = static_cast<int>(row.southWalls.size());
+        std::string line(width, '0');
+        for (auto x = 0; x < width; ++x)
+            line[x] += (x == width - 1 || row.eastWalls[x] ? 1 : 0) + (row.southWalls[x] ? 2 : 0);
+        out << line << '\n';
+    }
+
+    const Maze EllerMazeGenerator::generate() const noexcept {
+        const auto [width, height] = getDimensions().values();
+
+        // We start with all walls, and then copy in the rows as they are generated.
+        auto wi = createMazeLayout(getDimensions(), true);
+        generateRows(height, [&](const EllerRow &row) {
+            for (auto x = 0; x < width - 1; ++x)
+                wi[rankPos(types::pos(x, row.y, types::Direction::EAST))] = row.eastWalls[x];
+            if (row.y < height - 1)
+                for (auto x = 0; x < width; ++x)
+                    wi[rankPos(types::pos(x, row.y, types::Direction::SOUTH))] = row.southWalls[x];
+        });
+
         return Maze(getDimensions(), wi);
     }
-}
\ No newline at end of file
+}
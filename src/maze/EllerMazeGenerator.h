@@ -10,6 +10,10 @@
 
 #pragma once
 
+#include <functional>
+#include <ostream>
+#include <vector>
+
 #include <types/Dimensions2D.h>
 
 #include "MazeGenerator.h"
@@ -17,6 +21,57 @@
 namespace spelunker::maze {
     class Maze;
 
+    /// A single row of a maze generated by Eller's algorithm.
+    struct EllerRow {
+        /// The index of the row.
+        int y;
+
+        /// For each x in [0, width-1), whether there is a wall between (x,y) and (x+1,y).
+        std::vector<bool> eastWalls;
+
+        /// For each x in [0, width), whether there is a wall between (x,y) and (x,y+1).
+        std::vector<bool> southWalls;
+    };
+
+    /**
+     * The state of Eller's algorithm between rows, which generates a maze one row at a time.
+     *
+     * Eller's algorithm only needs to know which cells of the current row are connected, so the stream only stores
+     * a set label for each cell of the current row, and can produce mazes of unbounded height in O(width) memory.
+     * The maze is only guaranteed to be perfect once a row has been generated as the last row.
+     */
+    class EllerRowStream final {
+    public:
+        /**
+         * Create a stream of rows.
+         * @param width the width of the maze
+         * @param p probability with which to adjoin two adjacent cells in different sets
+         * @param den density of vertical adjoining
+         */
+        EllerRowStream(int width, double p, double den);
+
+        /**
+         * Generate the next row of the maze.
+         * @param last if true, the row closes off the maze: all of its cells are joined, and it has no south passages
+         * @return the walls of the row
+         */
+        const EllerRow nextRow(bool last = false);
+
+        /// The index of the next row to be generated.
+        inline int getNextRowIndex() const noexcept {
+            return y;
+        }
+
+    private:
+        const int width;
+        const double probability;
+        const double density;
+        int y;
+
+        /// The set of each cell of the current row, labelled from [0, width).
+        std::vector<int> labels;
+    };
+
     /// Maze generator using Eller's algorithm.
     /**
      * This is a maze generator using Eller's algorithm.
@@ -92,6 +147,34 @@ namespace spelunker::maze {
 
         const Maze generate() const noexcept final;
 
+        /// A function to consume the rows of a maze as they are generated.
+        using RowSink = std::function<void(const EllerRow&)>;
+
+        /// Create a stream to generate an unbounded number of rows with the parameters of this generator.
+        EllerRowStream rowStream() const;
+
+        /**
+         * Generate a perfect maze with the width of this generator and the specified number of rows, passing each row
+         * to the sink as soon as it is generated instead of storing the maze.
+         * @param numRows the number of rows
+         * @param sink the consumer of the rows
+         */
+        void generateRows(int numRows, const RowSink &sink) const;
+
+        /**
+         * Generate a perfect maze with the width of this generator and the specified number of rows, writing each row
+         * to the stream as soon as it is generated in the format of @see{writeRow}.
+         * @param numRows the number of rows
+         * @param out the stream, e.g. a file
+         */
+        void generateRows(int numRows, std::ostream &out) const;
+
+        /**
+         * Write a row as a line of digits, one per cell, where bit 0 indicates a wall to the east of the cell and
+         * bit 1 indicates a wall to the south of the cell. The wall on the eastern boundary is always set.
+         */
+        static void writeRow(std::ostream &out, const EllerRow &row);
+
         static constexpr double defaultProbability = 0.5;
         static constexpr double defaultDensity = 0.5;
 
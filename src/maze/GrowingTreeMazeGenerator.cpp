@@ -4,11 +4,15 @@
  * By Sebastian Raaphorst, 2018.
  */
 
+#include <deque>
 #include <stdexcept>
 #include <string>
+#include <utility>
+#include <vector>
 
 #include <types/CommonMazeAttributes.h>
 #include <types/Dimensions2D.h>
+#include <types/Direction.h>
 #include <math/RNG.h>
 
 #include "Maze.h"
@@ -17,11 +21,209 @@
 #include "GrowingTreeMazeGenerator.h"
 
 namespace spelunker::maze {
+    namespace {
+        /**
+         * The active sets below store the collection C of cells by rank. Each supports:
+         * - select(), returning a handle to the cell chosen by the strategy;
+         * - get(handle), returning the rank of the cell;
+         * - remove(handle), removing the cell;
+         * - add(rk), adding a cell as the newest; and
+         * - empty().
+         * The handle is only valid until C is next modified.
+         */
+
+        /// NEWEST: a stack.
+        class NewestActiveSet final {
+        public:
+            bool empty() const noexcept { return cells.empty(); }
+            int select() const noexcept { return static_cast<int>(cells.size()) - 1; }
+            int get(const int handle) const noexcept { return cells[handle]; }
+            void remove(int) noexcept { cells.pop_back(); }
+            void add(const int rk) { cells.emplace_back(rk); }
+
+        private:
+            std::vector<int> cells;
+        };
+
+        /// OLDEST: a queue.
+        class OldestActiveSet final {
+        public:
+            bool empty() const noexcept { return cells.empty(); }
+            int select() const noexcept { return 0; }
+            int get(int) const noexcept { return cells.front(); }
+            void remove(int) noexcept { cells.pop_front(); }
+            void add(const int rk) { cells.emplace_back(rk); }
+
+        private:
+            std::deque<int> cells;
+        };
+
+        /// MIDDLE: C split into two deques, where the front of the second is always C[C.size() / 2].
+        class MiddleActiveSet final {
+        public:
+            bool empty() const noexcept { return back.empty(); }
+            int select() const noexcept { return 0; }
+            int get(int) const noexcept { return back.front(); }
+            void remove(int) {
+                back.pop_front();
+                rebalance();
+            }
+            void add(const int rk) {
+                back.emplace_back(rk);
+                rebalance();
+            }
+
+        private:
+            void rebalance() {
+                const auto half = (front.size() + back.size()) / 2;
+                while (front.size() > half) {
+                    back.emplace_front(front.back());
+                    front.pop_back();
+                }
+                while (front.size() < half) {
+                    front.emplace_back(back.front());
+                    back.pop_front();
+                }
+            }
+
+            std::deque<int> front;
+            std::deque<int> back;
+        };
+
+        /// RANDOM: an array in no particular order, so a cell is removed by swapping it with the last.
+        class RandomActiveSet final {
+        public:
+            bool empty() const noexcept { return cells.empty(); }
+            int select() const noexcept { return math::RNG::randomRange(static_cast<int>(cells.size())); }
+            int get(const int handle) const noexcept { return cells[handle]; }
+            void remove(const int handle) noexcept {
+                cells[handle] = cells.back();
+                cells.pop_back();
+            }
+            void add(const int rk) { cells.emplace_back(rk); }
+
+        private:
+            std::vector<int> cells;
+        };
+
+        /**
+         * A mix of strategies: every cell ever added is kept in order of addition, and a Fenwick tree counts the cells
+         * still in C, so the k-th cell of C can be found, and removed, in logarithmic time.
+         */
+        class MixedActiveSet final {
+        public:
+            MixedActiveSet(const GrowingTreeMazeGenerator::WeightedStrategies &strategies, const int numCells)
+                : strategies{strategies}, tree(numCells + 1, 0), numLive{0} {
+                cells.reserve(numCells);
+                for (const auto &s: strategies)
+                    totalWeight += s.second;
+                for (highBit = 1; highBit * 2 <= numCells; highBit *= 2);
+            }
+
+            bool empty() const noexcept { return numLive == 0; }
+
+            int select() const noexcept {
+                // Pick a strategy by weight. If rounding leaves us past the end, use the last.
+                auto p = math::RNG::randomProbability() * totalWeight;
+                auto strategy = strategies.back().first;
+                for (const auto &[s, weight]: strategies) {
+                    if (p < weight) {
+                        strategy = s;
+                        break;
+                    }
+                    p -= weight;
+                }
+
+                switch (strategy) {
+                    case GrowingTreeMazeGenerator::CellSelectionStrategy::OLDEST: return find(0);
+                    case GrowingTreeMazeGenerator::CellSelectionStrategy::NEWEST: return find(numLive - 1);
+                    case GrowingTreeMazeGenerator::CellSelectionStrategy::MIDDLE: return find(numLive / 2);
+                    case GrowingTreeMazeGenerator::CellSelectionStrategy::RANDOM: return find(math::RNG::randomRange(numLive));
+                }
+                return find(numLive - 1);
+            }
+
+            int get(const int handle) const noexcept { return cells[handle]; }
+
+            void remove(const int handle) noexcept {
+                update(handle, -1);
+                --numLive;
+            }
+
+            void add(const int rk) {
+                update(static_cast<int>(cells.size()), 1);
+                cells.emplace_back(rk);
+                ++numLive;
+            }
+
+        private:
+            void update(const int pos, const int delta) noexcept {
+                for (auto i = pos + 1; i < static_cast<int>(tree.size()); i += i & -i)
+                    tree[i] += delta;
+            }
+
+            /// The position of the k-th (from 0) cell in C, by descending the Fenwick tree.
+            int find(int k) const noexcept {
+                auto pos = 0;
+                for (auto step = highBit; step > 0; step /= 2)
+                    if (pos + step < static_cast<int>(tree.size()) && tree[pos + step] <= k) {
+                        pos += step;
+                        k -= tree[pos];
+                    }
+                return pos;
+            }
+
+            const GrowingTreeMazeGenerator::WeightedStrategies &strategies;
+            double totalWeight = 0;
+            std::vector<int> cells;
+            std::vector<int> tree;
+            int highBit;
+            int numLive;
+        };
+
+        /// A user selector, which requires C as a CellCollection.
+        class SelectorActiveSet final {
+        public:
+            SelectorActiveSet(const GrowingTreeMazeGenerator::Selector &selector, const int width)
+                : selector{selector}, width{width} {}
+
+            bool empty() const noexcept { return cells.empty(); }
+            int select() const { return selector(cells); }
+            int get(const int handle) const noexcept { return cells[handle].second * width + cells[handle].first; }
+            void remove(const int handle) { cells.erase(cells.begin() + handle); }
+            void add(const int rk) { cells.emplace_back(types::cell(rk % width, rk / width)); }
+
+        private:
+            const GrowingTreeMazeGenerator::Selector &selector;
+            const int width;
+            types::CellCollection cells;
+        };
+    }
+
     GrowingTreeMazeGenerator::GrowingTreeMazeGenerator(const types::Dimensions2D &d, const CellSelectionStrategy &sel)
-        : GrowingTreeMazeGenerator{d, getSelector(sel)} {}
+        : GrowingTreeMazeGenerator{d, WeightedStrategies{{sel, 1.0}}} {}
 
     GrowingTreeMazeGenerator::GrowingTreeMazeGenerator(const int w, const int h, const CellSelectionStrategy &sel)
-        : GrowingTreeMazeGenerator{types::Dimensions2D{w, h}, getSelector(sel)} {}
+        : GrowingTreeMazeGenerator{types::Dimensions2D{w, h}, sel} {}
+
+    GrowingTreeMazeGenerator::GrowingTreeMazeGenerator(const types::Dimensions2D &d,
+                                                       const WeightedStrategies &strategies)
+        : MazeGenerator{d}, strategies{strategies} {
+        if (strategies.empty())
+            throw std::invalid_argument("At least one cell selection strategy is required.");
+
+        auto totalWeight = 0.0;
+        for (const auto &s: strategies) {
+            if (!(s.second >= 0))
+                throw std::invalid_argument("Strategy weight " + std::to_string(s.second) + " is negative.");
+            totalWeight += s.second;
+        }
+        if (!(totalWeight > 0))
+            throw std::invalid_argument("Strategy weights must not all be zero.");
+    }
+
+    GrowingTreeMazeGenerator::GrowingTreeMazeGenerator(const int w, const int h, const WeightedStrategies &strategies)
+        : GrowingTreeMazeGenerator{types::Dimensions2D{w, h}, strategies} {}
 
     GrowingTreeMazeGenerator::GrowingTreeMazeGenerator(const types::Dimensions2D &d, Selector sel)
         : MazeGenerator{d}, selector{sel} {}
@@ -30,51 +232,80 @@ namespace spelunker::maze {
         : GrowingTreeMazeGenerator{types::Dimensions2D{w, h}, sel} {}
 
     const Maze GrowingTreeMazeGenerator::generate() const noexcept {
+        if (strategies.empty()) {
+            SelectorActiveSet C{selector, getWidth()};
+            return generateWith(C);
+        }
+
+        if (strategies.size() > 1) {
+            MixedActiveSet C{strategies, getWidth() * getHeight()};
+            return generateWith(C);
+        }
+
+        switch (strategies.front().first) {
+            case CellSelectionStrategy::OLDEST: {
+                OldestActiveSet C;
+                return generateWith(C);
+            }
+            case CellSelectionStrategy::MIDDLE: {
+                MiddleActiveSet C;
+                return generateWith(C);
+            }
+            case CellSelectionStrategy::RANDOM: {
+                RandomActiveSet C;
+                return generateWith(C);
+            }
+            default: {
+                NewestActiveSet C;
+                return generateWith(C);
+            }
+        }
+    }
+
+    template<typename ActiveSet>
+    const Maze GrowingTreeMazeGenerator::generateWith(ActiveSet &C) const noexcept {
         const auto [width, height] = getDimensions().values();
 
         // We start with all walls, and then remove them iteratively.
         auto wi = createMazeLayout(getDimensions(), true);
 
         // We need a cell lookup to check if we have visited a cell already.
-        auto ci = types::initializeCellIndicator(getDimensions(), false);
+        std::vector<char> visited(width * height, false);
 
-        // Create the cell collection and pick a starting cell.
-        types::CellCollection C;
-        C.emplace_back(types::cell(math::RNG::randomRange(width), math::RNG::randomRange(height)));
+        // Pick a starting cell.
+        const auto startX = math::RNG::randomRange(width);
+        const auto startY = math::RNG::randomRange(height);
+        visited[rankCell(startX, startY)] = true;
+        C.add(rankCell(startX, startY));
 
         while (!C.empty()) {
-            // Select the element c using the selector.
-            const auto idx = selector(C);
-//            if (idx < 0 || idx >= C.size())
-//                throw std::out_of_range("C has size " + std::to_string(C.size()) + ", selector tried to pick " + std::to_string(idx));
-            const auto c = C[idx];
-            const auto [x, y] = c;
-            ci[x][y] = true;
-
-            // Find a list of unvisited neighbours. If we can't find one, continue.
-            const auto nbrs = unvisitedNeighbours(c, ci);
-            if (nbrs.empty()) {
-                C.erase(C.begin() + idx);
+            // Select the element c using the strategy.
+            const auto handle = C.select();
+            const auto [x, y] = unrankCell(C.get(handle));
+
+            // Find the unvisited neighbours. If there are none, remove c from C and continue.
+            types::Direction dirs[4];
+            const auto numAll = neighbourDirections(x, y, dirs);
+            auto numDirs = 0;
+            for (auto i = 0; i < numAll; ++i) {
+                const auto [nx, ny] = types::applyDirectionToCell(types::cell(x, y), dirs[i]);
+                if (!visited[rankCell(nx, ny)])
+                    dirs[numDirs++] = dirs[i];
+            }
+            if (numDirs == 0) {
+                C.remove(handle);
                 continue;
             }
 
             // Pick an unvisited neighbour, remove the wall to it, and add it to C.
-            const auto nbr = math::RNG::randomElement(nbrs);
-            auto [nbrx, nbry] = nbr.first;
-            ci[nbrx][nbry] = true;
-            wi[rankPos(nbr)] = false;
-            C.emplace_back(nbr.first);
+            const auto dir = dirs[math::RNG::randomRange(numDirs)];
+            const auto nbr = types::applyDirectionToCell(types::cell(x, y), dir);
+            const auto nbrRk = rankCell(nbr.first, nbr.second);
+            visited[nbrRk] = true;
+            wi[rankPos(types::pos(x, y, dir))] = false;
+            C.add(nbrRk);
         }
 
         return Maze(getDimensions(), wi);
     }
-
-    GrowingTreeMazeGenerator::Selector GrowingTreeMazeGenerator::getSelector(const CellSelectionStrategy css) {
-        switch (css) {
-            case CellSelectionStrategy::OLDEST: return [](const types::CellCollection &c) { return 0; };
-            case CellSelectionStrategy::NEWEST: return [](const types::CellCollection &c) { return c.size() - 1; };
-            case CellSelectionStrategy::MIDDLE: return [](const types::CellCollection &c) { return c.size() / 2; };
-            case CellSelectionStrategy::RANDOM: return [](const types::CellCollection &c) { return math::RNG::randomRange(c.size()); };
-        }
-    }
-}
\ No newline at end of file
+}
@@ -11,6 +11,8 @@
 #pragma once
 
 #include <functional>
+#include <utility>
+#include <vector>
 
 #include <types/CommonMazeAttributes.h>
 #include <types/Dimensions2D.h>
@@ -52,6 +54,14 @@ namespace spelunker::maze {
      *
      * Note that elements are emplaced at the back of C, so 0 is the oldest element, and C.size() - 1
      * is the newest.
+     *
+     * Strategies may also be mixed by weight, e.g. picking the newest cell 75% of the time and a random cell
+     * otherwise, which tunes the texture of the maze between that of depth-first search and Prim's.
+     *
+     * C is stored in a structure suited to the strategy, so that selecting and removing a cell takes constant time:
+     * a stack for NEWEST, a queue for OLDEST, a pair of deques split at the middle for MIDDLE, and an unordered array
+     * with swap-removal for RANDOM. Mixed strategies keep C in order with a Fenwick tree over the live cells, taking
+     * logarithmic time. A user selector requires C as a CellCollection, and removal from it takes linear time.
      */
     class GrowingTreeMazeGenerator final : public MazeGenerator {
     public:
@@ -64,6 +74,9 @@ namespace spelunker::maze {
             RANDOM
         };
 
+        /// A mix of strategies, each chosen at every step with probability proportional to its weight.
+        using WeightedStrategies = std::vector<std::pair<CellSelectionStrategy, double>>;
+
         /// Create a growing tree maze generator with a predetermined cell selection strategy.
         /**
          * Create a growing tree maze generator with a predetermined cell selection strategy.
@@ -81,6 +94,25 @@ namespace spelunker::maze {
          */
         GrowingTreeMazeGenerator(int w, int h, const CellSelectionStrategy &strategy);
 
+        /// Create a growing tree maze generator with a weighted mix of the predetermined strategies.
+        /**
+         * Create a growing tree maze generator with a weighted mix of the predetermined strategies.
+         * @param d dimension of the mazes to produce
+         * @param strategies the strategies and their nonnegative weights, not all zero
+         * @throws std::invalid_argument if there are no strategies, or the weights are invalid
+         */
+        GrowingTreeMazeGenerator(const types::Dimensions2D &d, const WeightedStrategies &strategies);
+
+        /// Create a growing tree maze generator with a weighted mix of the predetermined strategies.
+        /**
+         * Create a growing tree maze generator with a weighted mix of the predetermined strategies.
+         * @param w width of mazes to produce
+         * @param h height of mazes to produce
+         * @param strategies the strategies and their nonnegative weights, not all zero
+         * @throws std::invalid_argument if there are no strategies, or the weights are invalid
+         */
+        GrowingTreeMazeGenerator(int w, int h, const WeightedStrategies &strategies);
+
         /// Create a growing tree maze generator with a user-specified selector.
         /**
          * Create a growing tree maze generator with a user-specified selector.
@@ -103,11 +135,15 @@ namespace spelunker::maze {
         const Maze generate() const noexcept final;
 
     private:
-        /// The selection function. Should return an index of the CellCollection. Only called if it contains elements.
+        /// The strategies and their weights, or empty if a user selector is used.
+        const WeightedStrategies strategies;
+
+        /// The user selection function. Should return an index of the CellCollection. Only called if it contains elements.
         const Selector selector;
 
-        /// Given a CellSelectionStrategy, return its selector.
-        static Selector getSelector(CellSelectionStrategy css);
+        /// Run the algorithm with C stored in the given active set.
+        template<typename ActiveSet>
+        const Maze generateWith(ActiveSet &C) const noexcept;
     };
 }
 
@@ -4,6 +4,10 @@
  * By Sebastian Raaphorst, 2018.
  */
 
+#include <cstdint>
+#include <vector>
+
+#include <types/BitUtils.h>
 #include <types/CommonMazeAttributes.h>
 #include <types/Dimensions2D.h>
 #include <math/RNG.h>
@@ -26,67 +30,97 @@ namespace spelunker::maze {
         // We start with all walls, and then remove them iteratively.
         auto wi = createMazeLayout(getDimensions(), true);
 
-        // We need a cell lookup to check if we have visited a cell already.
-        auto ci = types::initializeCellIndicator(getDimensions(), false);
+        // The walls east and south of a cell, as ranked by Maze::rankPositionS.
+        const auto eastWall = [width, height](int x, int y) { return x * height + y + width * (height - 1); };
+        const auto southWall = [width](int x, int y) { return y * width + x; };
+
+        // We keep bitmaps, one per row, of the visited cells and of the hunt frontier, i.e. the unvisited cells with
+        // a visited neighbour. We also keep a bitmap of the rows where the frontier is nonempty, so that a hunt only
+        // scans words instead of cells.
+        const auto rowWords = types::numWords(width);
+        std::vector<std::uint64_t> visited(rowWords * height, 0);
+        std::vector<std::uint64_t> frontier(rowWords * height, 0);
+        std::vector<int> frontierSizes(height, 0);
+        std::vector<std::uint64_t> frontierRows(types::numWords(height), 0);
+
+        const auto isVisited = [&](int x, int y) { return types::testBit(&visited[y * rowWords], x); };
+        const auto addToFrontier = [&](int x, int y) {
+            auto *row = &frontier[y * rowWords];
+            if (isVisited(x, y) || types::testBit(row, x)) return;
+            types::setBit(row, x);
+            if (frontierSizes[y]++ == 0)
+                types::setBit(frontierRows.data(), y);
+        };
+        const auto visit = [&](int x, int y) {
+            types::setBit(&visited[y * rowWords], x);
+            auto *row = &frontier[y * rowWords];
+            if (types::testBit(row, x)) {
+                types::clearBit(row, x);
+                if (--frontierSizes[y] == 0)
+                    types::clearBit(frontierRows.data(), y);
+            }
+            if (x > 0)          addToFrontier(x - 1, y);
+            if (y > 0)          addToFrontier(x, y - 1);
+            if (x < width - 1)  addToFrontier(x + 1, y);
+            if (y < height - 1) addToFrontier(x, y + 1);
+        };
+
+        // Find the visited or unvisited neighbours of a cell, in the same order as MazeGenerator::neighbours, so
+        // that the mazes generated are the same as for a hunt that scans cell by cell.
+        struct Neighbour {
+            int x;
+            int y;
+            WallID wall;
+        };
+        const auto neighbours = [&](int x, int y, bool wantVisited, Neighbour *nbrs) {
+            auto n = 0;
+            if (x > 0 && isVisited(x - 1, y) == wantVisited)
+                nbrs[n++] = Neighbour{x - 1, y, eastWall(x - 1, y)};
+            if (y > 0 && isVisited(x, y - 1) == wantVisited)
+                nbrs[n++] = Neighbour{x, y - 1, southWall(x, y - 1)};
+            if (x < width - 1 && isVisited(x + 1, y) == wantVisited)
+                nbrs[n++] = Neighbour{x + 1, y, eastWall(x, y)};
+            if (y < height - 1 && isVisited(x, y + 1) == wantVisited)
+                nbrs[n++] = Neighbour{x, y + 1, southWall(x, y)};
+            return n;
+        };
 
         // Get a starting cell.
-        auto currX = math::RNG::randomRange(width);
-        auto currY = math::RNG::randomRange(height);
-
-        // We keep track of where to search when we start fresh.
-        auto nextX = 0;
-        auto nextY = 0;
-
-        while (currX < width && currY < height) {
-            randomPathCarving(currX, currY, ci, wi);
-
-            // Start scanning back at top, since we may have passed cells we were not
-            // adjacent to but now are.
-            nextX = 0;
-            nextY = 0;
-
-            while (nextX < width && nextY < height) {
-                // If unvisited, check to see if visited nbrs.
-                // If a visited nbr, break out of this loop.
-                if (!ci[nextX][nextY]) {
-                    const auto nbrs = visitedNeighbours(types::cell(nextX, nextY), ci);
-                    if (!nbrs.empty()) {
-                        const auto nbr = math::RNG::randomElement(nbrs);
-                        wi[rankPos(nbr)] = false;
-                        break;
-                    }
-                }
-                const int newX = nextX + 1;
-                nextX = newX % width;
-                nextY += newX / width;
+        auto x = math::RNG::randomRange(width);
+        auto y = math::RNG::randomRange(height);
+        Neighbour nbrs[4];
+
+        for (;;) {
+            // Continuously carve to an adjacent unvisited cell until there are none.
+            for (;;) {
+                visit(x, y);
+                const auto n = neighbours(x, y, false, nbrs);
+                if (n == 0) break;
+                const auto &nbr = nbrs[math::RNG::randomRange(n)];
+                wi[nbr.wall] = false;
+                x = nbr.x;
+                y = nbr.y;
             }
 
-            currX = nextX;
-            currY = nextY;
+            // Hunt for the first frontier cell, scanning from the top left. If there is none, we are done.
+            auto word = 0;
+            while (word < static_cast<int>(frontierRows.size()) && !frontierRows[word])
+                ++word;
+            if (word == static_cast<int>(frontierRows.size()))
+                break;
+            y = word * types::WordBits + types::countTrailingZeros(frontierRows[word]);
+
+            const auto *row = &frontier[y * rowWords];
+            word = 0;
+            while (!row[word])
+                ++word;
+            x = word * types::WordBits + types::countTrailingZeros(row[word]);
+
+            // Join it to a random visited neighbour, and continue carving from it.
+            const auto n = neighbours(x, y, true, nbrs);
+            wi[nbrs[math::RNG::randomRange(n)].wall] = false;
         }
 
         return Maze(getDimensions(), wi);
     }
-
-    void HuntAndKillMazeGenerator::randomPathCarving(const int startX,
-                                                     const int startY,
-                                                     types::CellIndicator &ci,
-                                                     WallIncidence &wi) const noexcept {
-        int x = startX;
-        int y = startY;
-
-        for (;;) {
-            // Mark the cell as visited.
-            ci[x][y] = true;
-            
-            // Continuously carve to an adjacent unvisited cell.
-            const auto nbrs = unvisitedNeighbours(types::cell(x, y), ci);
-            if (nbrs.empty()) break;
-            const auto nbr = math::RNG::randomElement(nbrs);
-            wi[rankPos(nbr)] = false;
-
-            x = nbr.first.first;
-            y = nbr.first.second;
-        }
-    }
-}
\ No newline at end of file
+}
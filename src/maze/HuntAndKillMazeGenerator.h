@@ -25,6 +25,9 @@ namespace spelunker::maze {
      * with the formerly uncovered node.
      *
      * When no such node can be found, we are done and the result is a perfect maze.
+     *
+     * The hunt scans the maze row by row from the top left. Rather than examining every cell, we maintain bitmaps
+     * of the unvisited cells with visited neighbours and of the rows containing them, so each hunt only scans words.
      */
     class HuntAndKillMazeGenerator final : public MazeGenerator {
     public:
@@ -33,9 +36,6 @@ namespace spelunker::maze {
         ~HuntAndKillMazeGenerator() final = default;
 
         const Maze generate() const noexcept final;
-
-    private:
-        void randomPathCarving(int startX, int startY, types::CellIndicator &ci, WallIncidence &wi) const noexcept;
     };
 };
 
@@ -4,12 +4,15 @@
  * By Sebastian Raaphorst, 2018.
  */
 
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <numeric>
 #include <vector>
-#include <boost/pending/disjoint_sets.hpp>
 
 #include <types/CommonMazeAttributes.h>
 #include <types/Dimensions2D.h>
-#include <types/DisjointSetHelper.h>
+#include <types/DisjointSets.h>
 #include <math/RNG.h>
 
 #include "Maze.h"
@@ -18,73 +21,78 @@
 #include "KruskalMazeGenerator.h"
 
 namespace spelunker::maze {
-    using namespace boost;
-
     KruskalMazeGenerator::KruskalMazeGenerator(const types::Dimensions2D &d)
         : MazeGenerator{d} {}
 
     KruskalMazeGenerator::KruskalMazeGenerator(const int w, const int h)
         : KruskalMazeGenerator{types::Dimensions2D{w, h}} {}
 
-    const Maze KruskalMazeGenerator::generate() const noexcept {
-        const auto [width, height] = getDimensions().values();
-
-        // We start with all walls, and then remove them iteratively.
-        auto wi = createMazeLayout(getDimensions(), true);
+    class KruskalMazeGenerator::Stepper final : public MazeStepper {
+    public:
+        explicit Stepper(const KruskalMazeGenerator &g)
+            : MazeStepper{g.getDimensions()},
+              gen{g},
+              wi(createMazeLayout(g.getDimensions(), true)),
+              walls(g.getNumWalls()),
+              dsets(g.getWidth() * g.getHeight()) {
+            // Create a collection of all possible walls.
+            std::iota(walls.begin(), walls.end(), 0);
+        }
 
-        // Create a collection of all possible walls.
-        std::vector<int> walls;
-        const int wallUpper = getNumWalls();
-        for (auto w = 0; w < wallUpper; ++w)
-            walls.emplace_back(w);
+        bool isDone() const noexcept final {
+            return next == walls.size() || dsets.getNumSets() <= 1;
+        }
 
-        // Get the map of wall ranks to adjacent cells.
-        auto unrank = createUnrankWallMap();
+        const Maze current() const final {
+            return Maze(getDimensions(), wi);
+        }
 
-        // Given a wall, find its adjacent cell.
-        // We need disjoint sets to represent the connected sets of cells.
-        // To do so efficiently, we use Boost's disjoint_sets with some helper classes and methods.
+    protected:
+        std::uint64_t run(const std::uint64_t maxSteps) final {
+            // Shuffle the walls as we go, exactly as math::RNG::shuffle would, so that every step is constant time.
+            std::uint64_t steps = 0;
+            for (; steps < maxSteps && !isDone(); ++steps, ++next) {
+                if (next + 1 < walls.size())
+                    std::swap(walls[next], walls[math::RNG::randomRange(static_cast<int>(next),
+                                                                          static_cast<int>(walls.size()))]);
 
-        // Create a vector of all elements.
-        std::vector<types::Element> elements;
-        elements.reserve(width * height);
-        for (auto x = 0; x < width; ++x)
-            for (auto y = 0; y < height; ++y)
-                elements.emplace_back(types::Element(rankCell(x, y)));
+                const auto w = walls[next];
+                const auto [c1, c2] = gen.unrankWallID(w);
 
-        for (auto i = 0; i < elements.size(); ++i)
-            elements[i].dsID = i;
+                const auto [cx1, cy1] = c1.first;
+                const auto cr1 = gen.rankCell(cx1, cy1);
 
-        // Create disjoint singleton sets.
-        types::Rank rank(elements);
-        types::Parent parent(elements);
-        boost::disjoint_sets<types::Rank *, types::Parent *> dsets(&rank, &parent);
-        for (auto &e: elements)
-            dsets.make_set(e);
+                const auto [cx2, cy2] = c2.first;
+                const auto cr2 = gen.rankCell(cx2, cy2);
 
-        // Shuffle the vector of walls and then iterate over them.
-        math::RNG::shuffle(walls);
+                // If the cells belong to separate partitions, remove the wall and join them.
+                if (dsets.unite(cr1, cr2))
+                    wi[w] = false;
+            }
+            return steps;
+        }
 
-        for (auto w : walls) {
-            const auto &pp = unrank[w];
+    private:
+        const KruskalMazeGenerator gen;
 
-            const auto [c1, c2] = pp;
+        // We start with all walls, and then remove them iteratively.
+        WallIncidence wi;
 
-            const auto [cx1, cy1] = c1.first;
-            const auto cr1 = rankCell(cx1, cy1);
+        // The walls, shuffled up to next, which is the next to consider.
+        std::vector<WallID> walls;
+        std::size_t next = 0;
 
-            const auto [cx2, cy2] = c2.first;
-            const auto cr2 = rankCell(cx2, cy2);
+        // We need disjoint sets to represent the connected sets of cells.
+        types::DisjointSets dsets;
+    };
 
-            // If the cells belong to separate partitions, remove the wall and join them.
-            const auto &set1 = dsets.find_set(elements[cr1]);
-            const auto &set2 = dsets.find_set(elements[cr2]);
-            if (set1 != set2) {
-                wi[w] = false;
-                dsets.link(set1, set2);
-            }
-        }
+    const Maze KruskalMazeGenerator::generate() const noexcept {
+        Stepper stepper{*this};
+        stepper.finish();
+        return stepper.current();
+    }
 
-        return Maze(getDimensions(), wi);
+    std::unique_ptr<MazeStepper> KruskalMazeGenerator::stepper() const {
+        return std::make_unique<Stepper>(*this);
     }
-}
\ No newline at end of file
+}
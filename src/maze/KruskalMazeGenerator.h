@@ -10,6 +10,7 @@
 
 #pragma once
 
+#include <memory>
 #include <vector>
 
 #include <types/Dimensions2D.h>
@@ -27,6 +28,15 @@ namespace spelunker::maze {
         ~KruskalMazeGenerator() final = default;
 
         const Maze generate() const noexcept final;
+
+        /**
+         * Begin a generation that can be advanced a bounded number of steps at a time, which produces the same
+         * mazes as @see{generate}. A step is the consideration of a wall.
+         */
+        std::unique_ptr<MazeStepper> stepper() const;
+
+    private:
+        class Stepper;
     };
 }
 
@@ -17,6 +17,7 @@
 #include <types/CommonMazeAttributes.h>
 #include <types/Direction.h>
 #include <types/Dimensions2D.h>
+#include <types/DisjointSets.h>
 #include <types/Exceptions.h>
 #include <types/Transformation.h>
 #include "MazeAttributes.h"
@@ -320,6 +321,70 @@ namespace spelunker::maze {
         return Maze(getDimensions(), getStartingCell(), getGoalCells(), wi);
     }
 
+    const Maze Maze::toggleWalls(const std::vector<types::Position> &positions) const {
+        WallIncidence wi = wallIncidence;
+        for (const auto &p: positions) {
+            const auto rk = rankPosition(p);
+            if (rk != -1)
+                wi[rk] = !wi[rk];
+        }
+        return Maze(getDimensions(), getStartingCell(), getGoalCells(), wi);
+    }
+
+    void Maze::regenerateRegion(const int x0, const int y0, const MazeGenerator &generator) {
+        const auto [w, h] = generator.getDimensions().values();
+        if (w == 0 || h == 0)
+            return;
+        checkCell(x0, y0);
+        checkCell(x0 + w - 1, y0 + h - 1);
+
+        const auto region = generator.generate();
+        const auto rank = [w](const int x, const int y) { return y * w + x; };
+
+        // The trees of the old forest of passages in the region.
+        types::DisjointSets oldTrees(w * h);
+        for (auto y = 0; y < h; ++y)
+            for (auto x = 0; x < w; ++x) {
+                if (x + 1 < w && !wall(x0 + x, y0 + y, types::Direction::EAST))
+                    oldTrees.unite(rank(x, y), rank(x + 1, y));
+                if (y + 1 < h && !wall(x0 + x, y0 + y, types::Direction::SOUTH))
+                    oldTrees.unite(rank(x, y), rank(x, y + 1));
+            }
+
+        // Decide the walls of the region in the order of the rules above, and then write them.
+        std::vector<bool> eastWalls(w * h, true);
+        std::vector<bool> southWalls(w * h, true);
+        types::DisjointSets newTrees(w * h);
+        const auto carve = [&](const int x, const int y, const types::Direction d, const bool sameTreeOnly) {
+            const auto rk1 = rank(x, y);
+            const auto rk2 = d == types::Direction::EAST ? rank(x + 1, y) : rank(x, y + 1);
+            if (sameTreeOnly && !oldTrees.connected(rk1, rk2))
+                return;
+            if (newTrees.unite(rk1, rk2))
+                (d == types::Direction::EAST ? eastWalls : southWalls)[rk1] = false;
+        };
+
+        for (const auto rule: {1, 2})
+            for (auto y = 0; y < h; ++y)
+                for (auto x = 0; x < w; ++x) {
+                    const auto &source = rule == 1 ? region : *this;
+                    const auto sx = rule == 1 ? x : x0 + x;
+                    const auto sy = rule == 1 ? y : y0 + y;
+                    if (x + 1 < w && !source.wall(sx, sy, types::Direction::EAST))
+                        carve(x, y, types::Direction::EAST, rule == 1);
+                    if (y + 1 < h && !source.wall(sx, sy, types::Direction::SOUTH))
+                        carve(x, y, types::Direction::SOUTH, rule == 1);
+                }
+
+        for (auto y = 0; y < h; ++y)
+            for (auto x = 0; x < w; ++x) {
+                if (x + 1 < w)
+                    wallIncidence[rankPosition(x0 + x, y0 + y, types::Direction::EAST)] = eastWalls[rank(x, y)];
+                if (y + 1 < h)
+                    wallIncidence[rankPosition(x0 + x, y0 + y, types::Direction::SOUTH)] = southWalls[rank(x, y)];
+            }
+    }
+
     int Maze::numCellWallsInWI(const spelunker::types::Cell &c, const spelunker::maze::WallIncidence &wi) const {
         checkCell(c);
 
@@ -174,6 +174,39 @@ namespace spelunker::maze {
          */
         const Maze braid(double probability) const noexcept override;
 
+        /// Toggle a collection of walls, carving those that exist and adding those that do not.
+        /**
+         * This performs the same operation that {@see braid} performs on a single wall, for runtime changes to a maze
+         * like opening doors. Bounding walls cannot be carved, and positions facing the boundary are ignored.
+         * Toggling the same wall twice restores it.
+         * @param positions the positions indicating the walls to toggle
+         * @return a new maze with the walls toggled
+         */
+        const Maze toggleWalls(const std::vector<types::Position> &positions) const;
+
+        /// Regenerate a rectangular region of a perfect maze in place, keeping it perfect.
+        /**
+         * Replace the passages inside the region with those of a maze produced by the generator, which determines the
+         * size of the region, leaving the rest of the maze, including the walls around the region, untouched.
+         * Unlike the other operations, this modifies the maze, so that the cost is proportional to the size of the
+         * region rather than that of the maze.
+         *
+         * The passages of the region form a forest, whose trees are joined through the outside of the region via
+         * the openings in its boundary. Which openings lead to the same part of the outside cannot be determined
+         * without exploring the outside, so instead, the openings are kept, and the new passages are made to
+         * connect exactly the same cells of the region as the old ones did:
+         * 1. the passages of the new maze are taken where they lie within a single tree of the old forest; and
+         * 2. the old passages are then used to rejoin the pieces of each tree.
+         * Every connection through the region is thus preserved, and the maze remains perfect. If the old passages
+         * connected the whole region, the new passages are exactly those of the generated maze.
+         *
+         * @param x0 the x coordinate of the northwest cell of the region
+         * @param y0 the y coordinate of the northwest cell of the region
+         * @param generator a generator of mazes of the size of the region
+         * @throws types::OutOfBoundsCoordinates if the region does not lie within the maze
+         */
+        void regenerateRegion(int x0, int y0, const MazeGenerator &generator);
+
         /// A static function used by rankPosition, separated out for testing.
         static WallID rankPositionS(const types::Dimensions2D &dim, int x, int y, types::Direction dir);
 
@@ -4,6 +4,10 @@
  * By Sebastian Raaphorst, 2018.
  */
 
+#include <algorithm>
+#include <cstdint>
+
+#include <types/BitUtils.h>
 #include <types/CommonMazeAttributes.h>
 #include <types/Dimensions2D.h>
 
@@ -27,4 +31,39 @@ namespace spelunker::maze {
     WallIncidence createMazeLayout(const types::Dimensions2D & d, bool walls) noexcept {
         return WallIncidence(calculateNumWalls(d), walls);
     }
-}
\ No newline at end of file
+
+    WallBitPlanes::WallBitPlanes(const int width, const int height)
+        : width{width}, height{height}, rowWords{types::numWords(width)},
+          east(static_cast<size_t>(rowWords) * height, ~std::uint64_t{0}),
+          south(static_cast<size_t>(rowWords) * height, ~std::uint64_t{0}) {}
+
+    WallIncidence createMazeLayout(const WallBitPlanes &planes) noexcept {
+        const auto width = planes.width;
+        const auto height = planes.height;
+        auto wi = createMazeLayout(width, height, true);
+
+        // Visit the cleared bits of the given interior columns of a row.
+        const auto forCarved = [&planes](const std::uint64_t *row, const int numCols, auto &&f) {
+            for (auto w = 0; w < planes.rowWords; ++w) {
+                const auto numBits = std::min(types::WordBits, numCols - w * types::WordBits);
+                if (numBits <= 0)
+                    break;
+                auto carved = ~row[w];
+                if (numBits < types::WordBits)
+                    carved &= (std::uint64_t{1} << numBits) - 1;
+                for (; carved; carved &= carved - 1)
+                    f(w * types::WordBits + types::countTrailingZeros(carved));
+            }
+        };
+
+        const auto numSouthWalls = width * (height - 1);
+        for (auto y = 0; y < height; ++y) {
+            if (y < height - 1)
+                forCarved(planes.southRow(y), width, [&wi, width, y](const int x) { wi[y * width + x] = false; });
+            forCarved(planes.eastRow(y), width - 1, [&wi, numSouthWalls, height, y](const int x) {
+                wi[numSouthWalls + x * height + y] = false;
+            });
+        }
+        return wi;
+    }
+}
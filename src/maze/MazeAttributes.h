@@ -8,7 +8,9 @@
 
 #pragma once
 
+#include <cstdint>
 #include <map>
+#include <utility>
 #include <vector>
 
 #include <types/CommonMazeAttributes.h>
@@ -32,6 +34,31 @@ namespace spelunker::maze {
     /// Used to reverse wall ranking, i.e. a map that takes a wall rank and gives the two cells it separates.
     using UnrankWallMap = std::map<WallID, std::pair<types::Position, types::Position>>;
 
+    /// Determine the two positions on either side of a wall, reversing @see{Maze::rankPositionS}.
+    /**
+     * The walls south of cells are ranked first, in row-major order, followed by the walls east of cells, in
+     * column-major order. Unranking thus requires only arithmetic, and no lookup table.
+     * The position in the northern or western cell is returned first.
+     * @param width the width of the maze
+     * @param height the height of the maze
+     * @param wall the rank of an interior wall, in [0, calculateNumWalls(width, height))
+     * @return the two positions facing the wall
+     */
+    constexpr std::pair<types::Position, types::Position> unrankWall(const int width,
+                                                                     const int height,
+                                                                     const WallID wall) noexcept {
+        const auto numSouthWalls = width * (height - 1);
+        if (wall < numSouthWalls) {
+            const auto x = wall % width;
+            const auto y = wall / width;
+            return {{{x, y}, types::Direction::SOUTH}, {{x, y + 1}, types::Direction::NORTH}};
+        }
+
+        const auto x = (wall - numSouthWalls) / height;
+        const auto y = (wall - numSouthWalls) % height;
+        return {{{x, y}, types::Direction::EAST}, {{x + 1, y}, types::Direction::WEST}};
+    }
+
     /// Calculates the number of possible internal (non-boundary) walls in a maze of width w and height h.
     const int calculateNumWalls(int width, int height);
 
@@ -59,4 +86,28 @@ namespace spelunker::maze {
      * @return an "empty" layout
      */
     WallIncidence createMazeLayout(const types::Dimensions2D & d, bool walls = true) noexcept;
+
+    /**
+     * The walls of a maze stored as bit planes: for every row, a bitmap of the cells with a wall to their east, and a
+     * bitmap of the cells with a wall to their south, with bit x of word x / 64 for cell x. Each row is padded to
+     * whole words, so that different rows can be written concurrently. The bits for the boundary walls are ignored.
+     */
+    struct WallBitPlanes final {
+        /// Create the planes for a maze full of walls.
+        WallBitPlanes(int width, int height);
+
+        inline std::uint64_t *eastRow(const int y) noexcept { return east.data() + y * rowWords; }
+        inline const std::uint64_t *eastRow(const int y) const noexcept { return east.data() + y * rowWords; }
+        inline std::uint64_t *southRow(const int y) noexcept { return south.data() + y * rowWords; }
+        inline const std::uint64_t *southRow(const int y) const noexcept { return south.data() + y * rowWords; }
+
+        const int width;
+        const int height;
+        const int rowWords;
+        std::vector<std::uint64_t> east;
+        std::vector<std::uint64_t> south;
+    };
+
+    /// Create the layout of a maze from its bit planes, only visiting the carved walls.
+    WallIncidence createMazeLayout(const WallBitPlanes &planes) noexcept;
 }
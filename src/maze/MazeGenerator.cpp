@@ -4,8 +4,6 @@
  * By Sebastian Raaphorst, 2018.
  */
 
-#include <cassert>
-
 #include <types/CommonMazeAttributes.h>
 #include <types/Direction.h>
 #include "Maze.h"
@@ -21,28 +19,10 @@ namespace spelunker::maze {
 
     const UnrankWallMap MazeGenerator::createUnrankWallMapS(const types::Dimensions2D &dim) noexcept {
         UnrankWallMap umap;
-
-        // The easiest way to do this is the inefficient way: iterate over all possible positions and collect
-        // up their wall ranks. We need a vector to do this, which we will turn into a pair since there should
-        // be two or a failure has occurred.
         const auto [width, height] = dim.values();
-        std::map<WallID, std::vector<types::Position>> unrankings;
-        for (auto x = 0; x < width; ++x)
-            for (auto y = 0; y < height; ++y) {
-                for (const auto dir : types::directions()) {
-                    const auto rk = Maze::rankPositionS(dim, x, y, dir);
-                    if (rk != -1)
-                        unrankings[rk].emplace_back(pos(x, y, dir));
-                }
-            }
-
-        // Now convert to pairs.
-        for (const auto &kv : unrankings) {
-            const auto &[rk, ps] = kv;
-            assert(ps.size() == 2);
-            umap.insert(std::make_pair(rk, std::make_pair(ps[0], ps[1])));
-        }
-
+        const auto numWalls = calculateNumWalls(dim);
+        for (auto rk = 0; rk < numWalls; ++rk)
+            umap.emplace_hint(umap.end(), rk, unrankWall(width, height, rk));
         return umap;
     }
 
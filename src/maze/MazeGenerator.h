@@ -11,13 +11,18 @@
 #include <functional>
 
 #include <types/AbstractMazeGenerator.h>
+#include <types/AbstractMazeStepper.h>
 #include <types/CommonMazeAttributes.h>
 #include <types/Dimensions2D.h>
+#include <types/Direction.h>
 #include "MazeAttributes.h"
 
 namespace spelunker::maze {
     class Maze;
 
+    /// A maze generation in progress, for generators that support advancing it a bounded amount of work at a time.
+    using MazeStepper = types::AbstractMazeStepper<Maze>;
+
     class MazeGenerator : public types::AbstractMazeGenerator<Maze> {
     public:
         MazeGenerator(const types::Dimensions2D &d);
@@ -27,13 +32,18 @@ namespace spelunker::maze {
 
         virtual const Maze generate() const noexcept = 0;
 
-        /// A static function used by unrankWallID, separated out for testing.
+        /// Create a map of every wall to the two Positions on either side of it, as given by @see{unrankWall}.
         static const UnrankWallMap createUnrankWallMapS(const types::Dimensions2D &dim) noexcept;
 
     protected:
         /// Create a map to reverse rankPosition: determine the two Positions on either side of a wall.
         const UnrankWallMap createUnrankWallMap() const noexcept;
 
+        /// Reverse rankPos: determine the two Positions on either side of a wall in constant time.
+        inline std::pair<types::Position, types::Position> unrankWallID(const WallID w) const noexcept {
+            return unrankWall(getWidth(), getHeight(), w);
+        }
+
         /// A function that maps Position to the corresponding ID of the wall in the maze.
         const WallID rankPos(const types::Position &p) const;
 
@@ -56,6 +66,23 @@ namespace spelunker::maze {
         /// Find all of the valid neighbours of a cell.
         const types::Neighbours allNeighbours(const types::Cell &c) const;
 
+        /**
+         * Find the directions leading from a cell to its neighbours without allocating, in the same order as
+         * @see{allNeighbours}: west, north, east, south.
+         * @param x the x coordinate of the cell
+         * @param y the y coordinate of the cell
+         * @param dirs the array to fill with the directions
+         * @return the number of directions
+         */
+        inline int neighbourDirections(const int x, const int y, types::Direction (&dirs)[4]) const noexcept {
+            auto numDirs = 0;
+            if (x - 1 >= 0)            dirs[numDirs++] = types::Direction::WEST;
+            if (y - 1 >= 0)            dirs[numDirs++] = types::Direction::NORTH;
+            if (x + 1 < getWidth())    dirs[numDirs++] = types::Direction::EAST;
+            if (y + 1 < getHeight())   dirs[numDirs++] = types::Direction::SOUTH;
+            return numDirs;
+        }
+
         inline int getNumWalls() const noexcept {
             return numWalls;
         }
@@ -12,12 +12,18 @@
 #include <types/Observer.h>
 
 namespace spelunker::maze {
-    // TODO:PLACEHOLDER
+    /**
+     * The signals a maze generator can emit to observers as it changes its maze, for use with @see{types::Observable}.
+     *   1. PassageCarved: the wall between two adjacent cells was removed.
+     *   2. CellAdded: a cell joined the maze.
+     *   3. PassageClosed: the wall between two adjacent cells was put back.
+     */
     struct MazeGeneratorSignalDescriptors {
-        enum { PassageCarved, CellAdded };
+        enum { PassageCarved, CellAdded, PassageClosed };
         using SignalTable = std::tuple<
-            types::Observer<void(const Cell &c1, const Cell &c2)>,
-            types::Observer<void(const Cell &c)>
+            types::Observer<void(const types::Cell &c1, const types::Cell &c2)>,
+            types::Observer<void(const types::Cell &c)>,
+            types::Observer<void(const types::Cell &c1, const types::Cell &c2)>
         >;
     };
 }
@@ -22,6 +22,7 @@
 #include "Maze.h"
 #include "MazeAttributes.h"
 #include "StringMazeRenderer.h"
+#include "VirtualMaze.h"
 
 namespace spelunker::typeclasses {
     template<>
@@ -37,6 +38,19 @@ namespace spelunker::typeclasses {
         using type = maze::Maze;
     };
 
+    template<>
+    struct Show<maze::VirtualMaze> {
+        static std::string show(const maze::VirtualMaze &m) {
+            std::ostringstream out;
+            maze::StringMazeRenderer r(out);
+            r.render(m);
+            return out.str();
+        }
+
+        static constexpr bool is_instance = true;
+        using type = maze::VirtualMaze;
+    };
+
     template<>
     struct Homomorphism<maze::Maze, thickmaze::ThickMaze> {
         static const thickmaze::ThickMaze morph(const maze::Maze &m) {
@@ -0,0 +1,200 @@
+/**
+ * MazeWorld.cpp
+ *
+ * By Sebastian Raaphorst, 2018.
+ */
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <utility>
+
+#include <types/Dimensions2D.h>
+#include <types/Direction.h>
+#include <types/Parallel.h>
+#include <math/CounterRNG.h>
+#include <math/DefaultRNG.h>
+#include <math/RNG.h>
+
+#include "Maze.h"
+#include "MazeGenerator.h"
+#include "MazeWorld.h"
+
+namespace spelunker::maze {
+    namespace {
+        /// Division rounding towards negative infinity, for the chunks of negative coordinates.
+        constexpr std::int64_t floorDiv(const std::int64_t a, const std::int64_t b) noexcept {
+            return a / b - ((a % b != 0 && (a < 0) != (b < 0)) ? 1 : 0);
+        }
+
+        /// The stream of the CounterRNG of a world for one purpose for a column of chunks.
+        std::uint64_t chunkStream(const std::int64_t chunkX, const std::uint64_t purpose) noexcept {
+            return math::mix64(static_cast<std::uint64_t>(chunkX)) ^ purpose;
+        }
+
+        /// The purposes of the streams: the seed of the RNG for the cells of the chunk, and the east and south doors.
+        constexpr std::uint64_t cellsPurpose = 0;
+        constexpr std::uint64_t eastDoorPurpose = 1;
+        constexpr std::uint64_t southDoorPurpose = 2;
+    }
+
+    MazeChunk::MazeChunk(const std::int64_t chunkX, const std::int64_t chunkY, Maze maze,
+                         const std::array<int, 4> &doors)
+        : chunkX{chunkX}, chunkY{chunkY}, maze{std::move(maze)}, doors{doors} {}
+
+    bool MazeChunk::wall(const int x, const int y, const types::Direction d) const {
+        switch (d) {
+            case types::Direction::NORTH:
+                if (y == 0) return x != doors[static_cast<int>(d)];
+                break;
+            case types::Direction::EAST:
+                if (x == maze.getWidth() - 1) return y != doors[static_cast<int>(d)];
+                break;
+            case types::Direction::SOUTH:
+                if (y == maze.getHeight() - 1) return x != doors[static_cast<int>(d)];
+                break;
+            case types::Direction::WEST:
+                if (x == 0) return y != doors[static_cast<int>(d)];
+                break;
+        }
+        return maze.wall(x, y, d);
+    }
+
+    MazeWorld::MazeWorld(const std::uint64_t seed, const types::Dimensions2D &chunkDimensions,
+                         ChunkGeneratorFactory factory, const std::size_t cacheCapacity,
+                         const unsigned int numBackgroundThreads)
+        : seed{seed}, chunkDimensions{chunkDimensions}, factory{std::move(factory)}, cacheCapacity{cacheCapacity} {
+        if (chunkDimensions.getWidth() <= 0 || chunkDimensions.getHeight() <= 0)
+            throw std::invalid_argument("Chunk dimensions must be positive.");
+        if (!this->factory)
+            throw std::invalid_argument("A chunk generator factory is required.");
+        if (cacheCapacity == 0)
+            throw std::invalid_argument("The chunk cache must have a positive capacity.");
+
+        // The group counts the thread waiting on it, which only happens on destruction.
+        if (numBackgroundThreads > 0)
+            background = std::make_unique<types::TaskGroup>(numBackgroundThreads + 1);
+    }
+
+    MazeWorld::~MazeWorld() {
+        // Abandon the chunks still waiting to be generated, and wait for those being generated.
+        stopping = true;
+        background.reset();
+    }
+
+    MazeChunk MazeWorld::generateChunk(const std::int64_t chunkX, const std::int64_t chunkY) const {
+        const math::CounterRNG rng{seed};
+        auto maze = [&] {
+            const math::RNG::ThreadRNGScope scope{std::make_shared<math::DefaultRNG>(
+                    rng(chunkStream(chunkX, cellsPurpose), static_cast<std::uint64_t>(chunkY)))};
+            return factory(chunkX, chunkY, chunkDimensions)->generate();
+        }();
+
+        // Each chunk owns the doors in its east and south sides, and takes the others from its neighbours.
+        std::array<int, 4> doors{};
+        doors[static_cast<int>(types::Direction::NORTH)] = doorOffset(chunkX, chunkY - 1, types::Direction::SOUTH);
+        doors[static_cast<int>(types::Direction::EAST)]  = doorOffset(chunkX, chunkY, types::Direction::EAST);
+        doors[static_cast<int>(types::Direction::SOUTH)] = doorOffset(chunkX, chunkY, types::Direction::SOUTH);
+        doors[static_cast<int>(types::Direction::WEST)]  = doorOffset(chunkX - 1, chunkY, types::Direction::EAST);
+        return MazeChunk{chunkX, chunkY, std::move(maze), doors};
+    }
+
+    std::shared_ptr<const MazeChunk> MazeWorld::chunk(const std::int64_t chunkX, const std::int64_t chunkY) {
+        const ChunkKey key{chunkX, chunkY};
+        std::unique_lock<std::mutex> lock{mutex};
+        const auto entry = lookup(key);
+        lock.unlock();
+
+        // If the chunk is still waiting to be generated in the background, generate it now instead.
+        fulfil(key, *entry.pending);
+        return entry.future.get();
+    }
+
+    void MazeWorld::prefetch(const std::int64_t chunkX, const std::int64_t chunkY, const int radius) {
+        if (!background)
+            return;
+
+        // The background threads take the oldest tasks first, so add the rings of chunks from the innermost out.
+        for (auto r = 0; r <= radius; ++r)
+            for (auto dy = -r; dy <= r; ++dy)
+                for (auto dx = -r; dx <= r; ++dx) {
+                    if (std::max(std::abs(dx), std::abs(dy)) != r)
+                        continue;
+
+                    const ChunkKey key{chunkX + dx, chunkY + dy};
+                    std::shared_ptr<PendingChunk> pending;
+                    {
+                        std::lock_guard<std::mutex> lock{mutex};
+                        pending = lookup(key).pending;
+                    }
+                    if (!pending->claimed)
+                        background->run([this, key, pending] {
+                            if (!stopping)
+                                fulfil(key, *pending);
+                        });
+                }
+    }
+
+    bool MazeWorld::wall(const std::int64_t x, const std::int64_t y, const types::Direction d) {
+        const auto [chunkX, chunkY] = chunkOf(x, y);
+        const auto c = chunk(chunkX, chunkY);
+        return c->wall(static_cast<int>(x - chunkX * chunkDimensions.getWidth()),
+                       static_cast<int>(y - chunkY * chunkDimensions.getHeight()), d);
+    }
+
+    std::pair<std::int64_t, std::int64_t> MazeWorld::chunkOf(const std::int64_t x, const std::int64_t y) const noexcept {
+        return {floorDiv(x, chunkDimensions.getWidth()), floorDiv(y, chunkDimensions.getHeight())};
+    }
+
+    std::size_t MazeWorld::numCachedChunks() const {
+        std::lock_guard<std::mutex> lock{mutex};
+        return cache.size();
+    }
+
+    const MazeWorld::CacheEntry &MazeWorld::lookup(const ChunkKey &key) {
+        const auto iter = cache.find(key);
+        if (iter != cache.end()) {
+            recency.splice(recency.begin(), recency, iter->second.position);
+            return iter->second;
+        }
+
+        auto pending = std::make_shared<PendingChunk>();
+        ChunkFuture future = pending->promise.get_future().share();
+        recency.push_front(key);
+        const auto &entry = cache.emplace(key, CacheEntry{std::move(future), std::move(pending), recency.begin()})
+                .first->second;
+
+        // Evicted chunks remain valid for anyone holding them.
+        while (cache.size() > cacheCapacity) {
+            cache.erase(recency.back());
+            recency.pop_back();
+        }
+        return entry;
+    }
+
+    void MazeWorld::fulfil(const ChunkKey &key, PendingChunk &pending) const noexcept {
+        if (pending.claimed.exchange(true))
+            return;
+        try {
+            pending.promise.set_value(std::make_shared<const MazeChunk>(generateChunk(key.first, key.second)));
+        } catch (...) {
+            pending.promise.set_exception(std::current_exception());
+        }
+    }
+
+    int MazeWorld::doorOffset(const std::int64_t chunkX, const std::int64_t chunkY,
+                              const types::Direction d) const noexcept {
+        const math::CounterRNG rng{seed};
+        if (d == types::Direction::EAST)
+            return rng.range(chunkStream(chunkX, eastDoorPurpose), static_cast<std::uint64_t>(chunkY),
+                             chunkDimensions.getHeight());
+        return rng.range(chunkStream(chunkX, southDoorPurpose), static_cast<std::uint64_t>(chunkY),
+                         chunkDimensions.getWidth());
+    }
+}
@@ -0,0 +1,177 @@
+/**
+ * MazeWorld.h
+ *
+ * By Sebastian Raaphorst, 2018.
+ *
+ * An unbounded maze, generated lazily in chunks.
+ */
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <utility>
+
+#include <types/Dimensions2D.h>
+#include <types/Direction.h>
+#include <types/Parallel.h>
+
+#include "Maze.h"
+#include "MazeGenerator.h"
+
+namespace spelunker::maze {
+    /**
+     * A chunk of a @see{MazeWorld}: a maze covering the cells of the chunk, and the doors in its boundary through
+     * which it connects to the neighbouring chunks.
+     */
+    struct MazeChunk final {
+        MazeChunk(std::int64_t chunkX, std::int64_t chunkY, Maze maze, const std::array<int, 4> &doors);
+
+        /**
+         * Determine if there is a wall in the given direction from a cell of the chunk, in coordinates relative to the
+         * chunk. Unlike the walls of the maze, the boundary walls have doors.
+         */
+        bool wall(int x, int y, types::Direction d) const;
+
+        const std::int64_t chunkX;
+        const std::int64_t chunkY;
+
+        /// The cells of the chunk. Its boundary is closed: see doors.
+        const Maze maze;
+
+        /// For each side of the chunk, indexed by @see{types::Direction}, the offset of the cell along it with a door.
+        const std::array<int, 4> doors;
+    };
+
+    /**
+     * An effectively infinite maze, divided into chunks that are generated on demand.
+     *
+     * A chunk is a pure function of the seed of the world and the coordinates of the chunk: its cells are generated by
+     * a @see{MazeGenerator} running with a @see{math::RNG} seeded from them, and every side shared by two chunks has a
+     * single door at an offset drawn from a @see{math::CounterRNG} for that side. Thus neighbouring chunks agree on
+     * their shared doors without either being generated, and chunks can be generated in any order.
+     *
+     * Provided the chunk generators produce connected mazes, the world is connected: every chunk is connected, and
+     * connected to all of its neighbours. Since every side has a door, the world has loops on the scale of the chunks,
+     * so it is not a perfect maze; no choice of doors made locally could guarantee both connectivity and perfection.
+     *
+     * Chunks are kept in a cache of bounded capacity, evicting the least recently used, and can be generated ahead of
+     * time on background threads, e.g. around a player.
+     */
+    class MazeWorld final {
+    public:
+        /**
+         * A function creating the generator for a chunk, called concurrently from multiple threads.
+         * It is passed the coordinates of the chunk and the dimensions of the chunks.
+         */
+        using ChunkGeneratorFactory =
+            std::function<std::unique_ptr<MazeGenerator>(std::int64_t chunkX, std::int64_t chunkY,
+                                                         const types::Dimensions2D&)>;
+
+        /**
+         * Create a world.
+         * @param seed the seed from which the world is generated
+         * @param chunkDimensions the dimensions of the chunks, which must be positive
+         * @param factory the factory creating the generator for each chunk
+         * @param cacheCapacity the maximum number of chunks to keep, at least one
+         * @param numBackgroundThreads the number of threads generating chunks ahead of time (0 to generate on demand)
+         * @throws std::invalid_argument if the parameters are invalid
+         */
+        MazeWorld(std::uint64_t seed, const types::Dimensions2D &chunkDimensions, ChunkGeneratorFactory factory,
+                  std::size_t cacheCapacity = defaultCacheCapacity, unsigned int numBackgroundThreads = 1);
+
+        ~MazeWorld();
+
+        MazeWorld(const MazeWorld&) = delete;
+        MazeWorld &operator=(const MazeWorld&) = delete;
+
+        /// Generate a chunk without consulting or changing the cache.
+        MazeChunk generateChunk(std::int64_t chunkX, std::int64_t chunkY) const;
+
+        /// Retrieve a chunk from the cache, generating it if necessary, or waiting for it if it is being generated.
+        std::shared_ptr<const MazeChunk> chunk(std::int64_t chunkX, std::int64_t chunkY);
+
+        /**
+         * Generate the chunks within the given distance of a chunk in the background, if they are not in the cache.
+         * The nearest chunks are generated first, and requests are served in the order in which they were made; a chunk
+         * that is needed before its turn comes is generated on demand by @see{chunk}.
+         * Note that if the chunks do not all fit in the cache, the least recently used will be evicted to make room.
+         */
+        void prefetch(std::int64_t chunkX, std::int64_t chunkY, int radius);
+
+        /// Determine if there is a wall in the given direction from a cell, in world coordinates.
+        bool wall(std::int64_t x, std::int64_t y, types::Direction d);
+
+        /// The coordinates of the chunk containing a cell.
+        std::pair<std::int64_t, std::int64_t> chunkOf(std::int64_t x, std::int64_t y) const noexcept;
+
+        /// The number of chunks currently in the cache, including those being generated.
+        std::size_t numCachedChunks() const;
+
+        inline std::uint64_t getSeed() const noexcept {
+            return seed;
+        }
+
+        inline const types::Dimensions2D &getChunkDimensions() const noexcept {
+            return chunkDimensions;
+        }
+
+        /// A factory creating a generator of type G for every chunk.
+        template<typename G>
+        static ChunkGeneratorFactory factoryFor() {
+            return [](std::int64_t, std::int64_t, const types::Dimensions2D &d) { return std::make_unique<G>(d); };
+        }
+
+        static constexpr std::size_t defaultCacheCapacity = 64;
+
+    private:
+        using ChunkKey = std::pair<std::int64_t, std::int64_t>;
+        using ChunkFuture = std::shared_future<std::shared_ptr<const MazeChunk>>;
+
+        /// A chunk to be generated by whichever thread claims it first: a background thread, or one needing it.
+        struct PendingChunk final {
+            std::promise<std::shared_ptr<const MazeChunk>> promise;
+            std::atomic<bool> claimed{false};
+        };
+
+        struct CacheEntry final {
+            ChunkFuture future;
+            std::shared_ptr<PendingChunk> pending;
+            std::list<ChunkKey>::iterator position;
+        };
+
+        /**
+         * Find a chunk in the cache, marking it as the most recently used, or else add an entry for it, evicting the
+         * least recently used chunk if the cache is full. The mutex must be held.
+         */
+        const CacheEntry &lookup(const ChunkKey &key);
+
+        /// Generate a chunk if no other thread has claimed it.
+        void fulfil(const ChunkKey &key, PendingChunk &pending) const noexcept;
+
+        /// The offset of the door in the east or south side of a chunk.
+        int doorOffset(std::int64_t chunkX, std::int64_t chunkY, types::Direction d) const noexcept;
+
+        const std::uint64_t seed;
+        const types::Dimensions2D chunkDimensions;
+        const ChunkGeneratorFactory factory;
+        const std::size_t cacheCapacity;
+
+        /// The cache: the chunks by key, and their keys from the most to the least recently used.
+        mutable std::mutex mutex;
+        std::map<ChunkKey, CacheEntry> cache;
+        std::list<ChunkKey> recency;
+
+        /// Background generation, abandoned once the world starts being destroyed.
+        std::atomic<bool> stopping{false};
+        std::unique_ptr<types::TaskGroup> background;
+    };
+}
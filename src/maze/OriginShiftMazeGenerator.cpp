@@ -0,0 +1,110 @@
+/**
+ * OriginShiftMazeGenerator.cpp
+ *
+ * By Sebastian Raaphorst, 2018.
+ */
+
+#include <cstdint>
+#include <vector>
+
+#include <math/RNG.h>
+#include <types/CommonMazeAttributes.h>
+#include <types/Dimensions2D.h>
+#include <types/Direction.h>
+
+#include "Maze.h"
+#include "MazeAttributes.h"
+#include "MazeGenerator.h"
+#include "MazeGeneratorSignalDescriptors.h"
+#include "OriginShiftMazeGenerator.h"
+
+namespace spelunker::maze {
+    OriginShiftMazeGenerator::OriginShiftMazeGenerator(const types::Dimensions2D &d, const std::uint64_t initialSteps)
+        : MazeGenerator{d},
+          parents(d.getWidth() * d.getHeight(), types::dirIdx(types::Direction::EAST)),
+          origin{types::cell(d.getWidth() - 1, d.getHeight() - 1)},
+          wallIncidence(createMazeLayout(d, true)) {
+
+        // Start with a comb: every row leads east into the last column, which leads south to the origin.
+        const auto [width, height] = d.values();
+        for (auto y = 0; y < height; ++y) {
+            for (auto x = 0; x + 1 < width; ++x)
+                wallIncidence[rankPos(types::pos(x, y, types::Direction::EAST))] = false;
+            if (y + 1 < height) {
+                parents[rankCell(width - 1, y)] = types::dirIdx(types::Direction::SOUTH);
+                wallIncidence[rankPos(types::pos(width - 1, y, types::Direction::SOUTH))] = false;
+            }
+        }
+        parents[rankCell(width - 1, height - 1)] = NoParent;
+
+        // Nobody can be observing yet, so skip the notifications.
+        shift(initialSteps, false);
+    }
+
+    OriginShiftMazeGenerator::OriginShiftMazeGenerator(const int w, const int h, const std::uint64_t initialSteps)
+        : OriginShiftMazeGenerator{types::Dimensions2D{w, h}, initialSteps} {}
+
+    OriginShiftMazeGenerator::OriginShiftMazeGenerator(const types::Dimensions2D &d)
+        : OriginShiftMazeGenerator{d, 0} {
+        shiftUntilCovered();
+    }
+
+    OriginShiftMazeGenerator::OriginShiftMazeGenerator(const int w, const int h)
+        : OriginShiftMazeGenerator{types::Dimensions2D{w, h}} {}
+
+    const Maze OriginShiftMazeGenerator::generate() const noexcept {
+        return Maze(getDimensions(), wallIncidence);
+    }
+
+    void OriginShiftMazeGenerator::step(const std::uint64_t n) {
+        shift(n, true);
+    }
+
+    void OriginShiftMazeGenerator::shift(const std::uint64_t n, const bool notifying) {
+        for (std::uint64_t i = 0; i < n && moveOrigin(notifying); ++i);
+    }
+
+    void OriginShiftMazeGenerator::shiftUntilCovered() {
+        const auto [width, height] = getDimensions().values();
+        std::vector<bool> visited(width * height, false);
+        visited[rankCell(origin.first, origin.second)] = true;
+        for (auto numUnvisited = width * height - 1; numUnvisited > 0 && moveOrigin(false);) {
+            const auto rk = rankCell(origin.first, origin.second);
+            if (!visited[rk]) {
+                visited[rk] = true;
+                --numUnvisited;
+            }
+        }
+    }
+
+    bool OriginShiftMazeGenerator::moveOrigin(const bool notifying) {
+        const auto [x, y] = origin;
+        types::Direction dirs[4];
+        const auto numDirs = neighbourDirections(x, y, dirs);
+        if (numDirs == 0)
+            return false;
+
+        // The old origin takes the neighbour as its parent.
+        const auto dir = dirs[math::RNG::randomRange(numDirs)];
+        const auto next = types::applyDirectionToCell(origin, dir);
+        const auto [nx, ny] = next;
+        parents[rankCell(x, y)] = types::dirIdx(dir);
+
+        // If the neighbour was a child of the old origin, the passage between them just reverses direction.
+        // Otherwise, the passage to the old origin is carved, and the one to the neighbour's parent is closed.
+        auto &nextParent = parents[rankCell(nx, ny)];
+        const auto parentDir = static_cast<types::Direction>(nextParent);
+        nextParent = NoParent;
+        origin = next;
+        if (parentDir == types::flip(dir))
+            return true;
+
+        wallIncidence[rankPos(types::pos(x, y, dir))] = false;
+        wallIncidence[rankPos(types::pos(nx, ny, parentDir))] = true;
+        if (notifying) {
+            notify<MazeGeneratorSignalDescriptors::PassageCarved>(types::cell(x, y), next);
+            notify<MazeGeneratorSignalDescriptors::PassageClosed>(next, types::applyDirectionToCell(next, parentDir));
+        }
+        return true;
+    }
+}
@@ -0,0 +1,84 @@
+/**
+ * OriginShiftMazeGenerator.h
+ *
+ * By Sebastian Raaphorst, 2018.
+ *
+ * A maze generator whose maze continuously evolves, one constant time step at a time, while staying perfect.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include <types/CommonMazeAttributes.h>
+#include <types/Dimensions2D.h>
+#include <types/Observable.h>
+
+#include "MazeAttributes.h"
+#include "MazeGenerator.h"
+#include "MazeGeneratorSignalDescriptors.h"
+
+namespace spelunker::maze {
+    class Maze;
+
+    /**
+     * A @see{MazeGenerator} that keeps a perfect maze as a spanning tree rooted at a cell called the origin, with
+     * every other cell recording the direction of its parent.
+     *
+     * Each step of the origin shift algorithm moves the origin to a random neighbour: the old origin takes the
+     * neighbour as its parent, and the neighbour, now the origin, forgets its own. This carves at most one passage and
+     * closes at most one, so the maze remains a spanning tree, and repeated steps converge to a uniformly random one.
+     *
+     * Unlike other generators, this one is stateful: @see{generate} returns the current maze, and @see{step} evolves it,
+     * notifying observers through the PassageCarved and PassageClosed signals of
+     * @see{MazeGeneratorSignalDescriptors}, so that a display can update only the walls that changed.
+     *
+     * The maze starts from a comb rooted at the southeast cell, shuffled by a given number of initial steps or, by
+     * default, until the origin has visited every cell. Every cell then takes the direction in which the origin last
+     * left it as its parent, so nothing of the comb remains. The walk covers the grid in about n log^2 n steps for n
+     * cells, so a fixed number of steps per cell would leave ever more of the comb in larger mazes.
+     */
+    class OriginShiftMazeGenerator final : public MazeGenerator,
+                                           public types::Observable<MazeGeneratorSignalDescriptors> {
+    public:
+        OriginShiftMazeGenerator(const types::Dimensions2D &d, std::uint64_t initialSteps);
+        OriginShiftMazeGenerator(int w, int h, std::uint64_t initialSteps);
+        OriginShiftMazeGenerator(const types::Dimensions2D &d);
+        OriginShiftMazeGenerator(int w, int h);
+        ~OriginShiftMazeGenerator() final = default;
+
+        /// Return the current maze.
+        const Maze generate() const noexcept final;
+
+        /// Move the origin n times, notifying observers of every wall that changes.
+        void step(std::uint64_t n = 1);
+
+        /// The root of the spanning tree.
+        inline const types::Cell &getOrigin() const noexcept {
+            return origin;
+        }
+
+    private:
+        /// Move the origin n times, notifying observers if requested.
+        void shift(std::uint64_t n, bool notifying);
+
+        /// Move the origin, without notifying observers, until it has visited every cell.
+        void shiftUntilCovered();
+
+        /**
+         * Move the origin to a random neighbour, notifying observers if requested.
+         * @return false if the origin has no neighbours, and true otherwise
+         */
+        bool moveOrigin(bool notifying);
+
+        /// The marker for the cell with no parent, i.e. the origin.
+        static constexpr std::uint8_t NoParent = 4;
+
+        /// The direction of the parent of every cell, by rank, as given by @see{types::dirIdx}.
+        std::vector<std::uint8_t> parents;
+
+        types::Cell origin;
+        WallIncidence wallIncidence;
+    };
+}
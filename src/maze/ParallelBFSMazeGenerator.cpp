@@ -0,0 +1,74 @@
+/**
+ * ParallelBFSMazeGenerator.cpp
+ *
+ * By Sebastian Raaphorst, 2018.
+ */
+
+#include <cstdint>
+#include <limits>
+
+#include <types/BitUtils.h>
+#include <types/Dimensions2D.h>
+#include <types/Direction.h>
+#include <types/Parallel.h>
+#include <math/CounterRNG.h>
+
+#include "Maze.h"
+#include "MazeAttributes.h"
+#include "MazeGenerator.h"
+#include "ParallelBFSMazeGenerator.h"
+
+namespace spelunker::maze {
+    ParallelBFSMazeGenerator::ParallelBFSMazeGenerator(const types::Dimensions2D &d, const unsigned int numThreads)
+        : MazeGenerator{d}, numThreads{numThreads} {}
+
+    ParallelBFSMazeGenerator::ParallelBFSMazeGenerator(const int w, const int h, const unsigned int numThreads)
+        : ParallelBFSMazeGenerator{types::Dimensions2D{w, h}, numThreads} {}
+
+    const Maze ParallelBFSMazeGenerator::generate() const noexcept {
+        return generate(math::CounterRNG::fromRNG().getSeed());
+    }
+
+    const Maze ParallelBFSMazeGenerator::generate(const std::uint64_t seed) const noexcept {
+        const auto [width, height] = getDimensions().values();
+        const math::CounterRNG rng{seed};
+
+        // The starting cell is drawn from a stream of its own.
+        constexpr auto startStream = std::numeric_limits<std::uint64_t>::max();
+        const auto startX = rng.range(startStream, 0, width);
+        const auto startY = rng.range(startStream, 1, height);
+
+        // The direction from a cell to the neighbour it connects to: a random one of those closer to the start.
+        const auto parent = [this, &rng, startX, startY](const int x, const int y) {
+            types::Direction dirs[2];
+            auto numDirs = 0;
+            if (x != startX) dirs[numDirs++] = x > startX ? types::Direction::WEST : types::Direction::EAST;
+            if (y != startY) dirs[numDirs++] = y > startY ? types::Direction::NORTH : types::Direction::SOUTH;
+            return numDirs == 1 ? dirs[0] : dirs[rng.range(static_cast<std::uint64_t>(rankCell(x, y)), 0, 2)];
+        };
+
+        // Start with all walls. The thread responsible for row y carves the walls east and south of its cells, which
+        // may be carved by the cells of row y, or by cells of row y + 1 connecting north.
+        WallBitPlanes planes{width, height};
+        types::parallelFor(0, height, numThreads, [&](int, int begin, int end) {
+            for (auto y = begin; y < end; ++y) {
+                auto east = planes.eastRow(y);
+                auto south = planes.southRow(y);
+                for (auto x = 0; x < width; ++x) {
+                    if (x != startX || y != startY) {
+                        switch (parent(x, y)) {
+                            case types::Direction::EAST:  types::clearBit(east, x);     break;
+                            case types::Direction::WEST:  types::clearBit(east, x - 1); break;
+                            case types::Direction::SOUTH: types::clearBit(south, x);    break;
+                            default: break;
+                        }
+                    }
+                    if (y + 1 < height && (x != startX || y + 1 != startY) && parent(x, y + 1) == types::Direction::NORTH)
+                        types::clearBit(south, x);
+                }
+            }
+        });
+
+        return Maze(getDimensions(), createMazeLayout(planes));
+    }
+}
@@ -0,0 +1,49 @@
+/**
+ * ParallelBFSMazeGenerator.h
+ *
+ * By Sebastian Raaphorst, 2018.
+ *
+ * A maze generator producing randomized breadth-first search trees, with every row of cells handled independently.
+ */
+
+#pragma once
+
+#include <cstdint>
+
+#include <types/Dimensions2D.h>
+
+#include "MazeGenerator.h"
+
+namespace spelunker::maze {
+    class Maze;
+
+    /**
+     * A @see{MazeGenerator} producing the same distribution of mazes as @see{BFSMazeGenerator}.
+     *
+     * In the randomized breadth-first search, a cell is connected to a random neighbour amongst those already in the
+     * maze when it is reached. Since the grid has no obstacles, the cells are reached in order of their Manhattan
+     * distance from the starting cell, and the neighbours already in the maze are exactly those one step closer to
+     * it: one along the row or column of the starting cell, and two elsewhere. Thus the frontiers of the search need
+     * not be expanded at all: every cell independently picks a random neighbour closer to the starting cell.
+     *
+     * The choices are drawn from a @see{math::CounterRNG} with a counter per cell, so each is a pure function of the
+     * cell. The rows of the maze are divided amongst the threads, and each thread writes the walls of its own rows of
+     * @see{WallBitPlanes}, recomputing the choice of any neighbouring cell that carves into them.
+     */
+    class ParallelBFSMazeGenerator final : public MazeGenerator {
+    public:
+        ParallelBFSMazeGenerator(const types::Dimensions2D &d, unsigned int numThreads = 0);
+        ParallelBFSMazeGenerator(int w, int h, unsigned int numThreads = 0);
+        ~ParallelBFSMazeGenerator() final = default;
+
+        /// Generate a maze, seeding the choices from @see{math::RNG}.
+        const Maze generate() const noexcept final;
+
+        /// Generate the maze for the given seed.
+        const Maze generate(std::uint64_t seed) const noexcept;
+
+    private:
+        /// The number of threads to use (0 meaning one per hardware thread).
+        const unsigned int numThreads;
+    };
+}
@@ -0,0 +1,75 @@
+/**
+ * ParallelBinaryTreeMazeGenerator.cpp
+ *
+ * By Sebastian Raaphorst, 2018.
+ */
+
+#include <cstdint>
+
+#include <types/BitUtils.h>
+#include <types/Dimensions2D.h>
+#include <types/Parallel.h>
+#include <math/CounterRNG.h>
+#include <math/MathUtils.h>
+
+#include "Maze.h"
+#include "MazeAttributes.h"
+#include "MazeGenerator.h"
+#include "ParallelBinaryTreeMazeGenerator.h"
+
+namespace spelunker::maze {
+    ParallelBinaryTreeMazeGenerator::ParallelBinaryTreeMazeGenerator(const types::Dimensions2D &d,
+                                                                     const double p,
+                                                                     const unsigned int numThreads)
+        : MazeGenerator{d}, eastProbability{p}, numThreads{numThreads} {
+        math::MathUtils::checkProbability(p);
+    }
+
+    ParallelBinaryTreeMazeGenerator::ParallelBinaryTreeMazeGenerator(const int w, const int h, const double p,
+                                                                     const unsigned int numThreads)
+        : ParallelBinaryTreeMazeGenerator{types::Dimensions2D{w, h}, p, numThreads} {}
+
+    ParallelBinaryTreeMazeGenerator::ParallelBinaryTreeMazeGenerator(const types::Dimensions2D &d)
+        : ParallelBinaryTreeMazeGenerator{d, defaultEastProbability} {}
+
+    ParallelBinaryTreeMazeGenerator::ParallelBinaryTreeMazeGenerator(const int w, const int h)
+        : ParallelBinaryTreeMazeGenerator{types::Dimensions2D{w, h}, defaultEastProbability} {}
+
+    const Maze ParallelBinaryTreeMazeGenerator::generate() const noexcept {
+        return generate(math::CounterRNG::fromRNG().getSeed());
+    }
+
+    const Maze ParallelBinaryTreeMazeGenerator::generate(const std::uint64_t seed) const noexcept {
+        const auto [width, height] = getDimensions().values();
+        const math::CounterRNG rng{seed};
+        WallBitPlanes planes{width, height};
+
+        // The bit of the easternmost cell within its word: that cell can only carve south.
+        const auto lastWord = (width - 1) / types::WordBits;
+        const auto lastBit = std::uint64_t{1} << static_cast<unsigned int>((width - 1) % types::WordBits);
+
+        types::parallelFor(0, height, numThreads, [&](int, int begin, int end) {
+            for (auto y = begin; y < end; ++y) {
+                auto east = planes.eastRow(y);
+                auto south = planes.southRow(y);
+
+                // Along the southmost row, it is only possible to carve east.
+                if (y == height - 1) {
+                    for (auto w = 0; w < planes.rowWords; ++w)
+                        east[w] = 0;
+                    continue;
+                }
+
+                for (auto w = 0; w < planes.rowWords; ++w) {
+                    auto carveEast = rng.bernoulliWord(static_cast<std::uint64_t>(y), w, eastProbability);
+                    if (w == lastWord)
+                        carveEast &= ~lastBit;
+                    east[w] = ~carveEast;
+                    south[w] = carveEast;
+                }
+            }
+        });
+
+        return Maze(getDimensions(), createMazeLayout(planes));
+    }
+}
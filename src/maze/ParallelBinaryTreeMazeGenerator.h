@@ -0,0 +1,53 @@
+/**
+ * ParallelBinaryTreeMazeGenerator.h
+ *
+ * By Sebastian Raaphorst, 2018.
+ *
+ * A maze generator using the binary tree approach on 64 cells at a time, across multiple threads.
+ */
+
+#pragma once
+
+#include <cstdint>
+
+#include <types/Dimensions2D.h>
+
+#include "MazeGenerator.h"
+
+namespace spelunker::maze {
+    class Maze;
+
+    /**
+     * A @see{MazeGenerator} producing the same distribution of mazes as @see{BinaryTreeMazeGenerator}.
+     *
+     * Every cell makes an independent choice between carving east and carving south, so a row of the maze is simply a
+     * word of random bits, each set with probability p, per 64 cells: the cells with a bit set carve east, and the
+     * others carve south. These words are written directly into the @see{WallBitPlanes} of the maze, with the rows
+     * divided amongst the threads.
+     *
+     * The words are drawn from a @see{math::CounterRNG} with a stream per row, so the maze for a seed can also be
+     * queried without being generated through @see{VirtualBinaryTreeMaze}.
+     */
+    class ParallelBinaryTreeMazeGenerator final : public MazeGenerator {
+    public:
+        ParallelBinaryTreeMazeGenerator(const types::Dimensions2D &d, double p, unsigned int numThreads = 0);
+        ParallelBinaryTreeMazeGenerator(int w, int h, double p, unsigned int numThreads = 0);
+        ParallelBinaryTreeMazeGenerator(const types::Dimensions2D &d);
+        ParallelBinaryTreeMazeGenerator(int w, int h);
+        ~ParallelBinaryTreeMazeGenerator() final = default;
+
+        /// Generate a maze, seeding the rows from @see{math::RNG}.
+        const Maze generate() const noexcept final;
+
+        /// Generate the maze for the given seed.
+        const Maze generate(std::uint64_t seed) const noexcept;
+
+        static constexpr double defaultEastProbability = 0.5;
+
+    private:
+        const double eastProbability;
+
+        /// The number of threads to use (0 meaning one per hardware thread).
+        const unsigned int numThreads;
+    };
+}
@@ -0,0 +1,155 @@
+/**
+ * ParallelKruskalMazeGenerator.cpp
+ *
+ * By Sebastian Raaphorst, 2018.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <utility>
+#include <vector>
+
+#include <types/Dimensions2D.h>
+#include <types/Parallel.h>
+#include <math/CounterRNG.h>
+
+#include "Maze.h"
+#include "MazeAttributes.h"
+#include "MazeGenerator.h"
+#include "ParallelKruskalMazeGenerator.h"
+
+namespace spelunker::maze {
+    ParallelKruskalMazeGenerator::ParallelKruskalMazeGenerator(const types::Dimensions2D &d,
+                                                               const unsigned int numThreads)
+        : MazeGenerator{d}, numThreads{numThreads} {}
+
+    ParallelKruskalMazeGenerator::ParallelKruskalMazeGenerator(const int w, const int h, const unsigned int numThreads)
+        : ParallelKruskalMazeGenerator{types::Dimensions2D{w, h}, numThreads} {}
+
+    const Maze ParallelKruskalMazeGenerator::generate() const noexcept {
+        return generate(math::CounterRNG::fromRNG().getSeed());
+    }
+
+    const Maze ParallelKruskalMazeGenerator::generate(const std::uint64_t seed) const noexcept {
+        const auto [width, height] = getDimensions().values();
+        const auto numCells = width * height;
+        const auto numWalls = getNumWalls();
+        const auto threads = numThreads == 0 ? types::defaultNumThreads() : numThreads;
+        const math::CounterRNG rng{seed};
+
+        // The weight of a wall is a random value with its low bits replaced by the wall ID, so that all weights are
+        // distinct and the wall can be recovered from its weight.
+        auto idBits = 1;
+        while ((std::int64_t{1} << idBits) < numWalls)
+            ++idBits;
+        const auto idMask = (std::uint64_t{1} << idBits) - 1;
+        const auto weight = [&rng, idMask](const WallID w) {
+            return (rng(w) & ~idMask) | static_cast<std::uint64_t>(w);
+        };
+        constexpr auto NoWall = std::numeric_limits<std::uint64_t>::max();
+
+        const auto wallCells = [this, width, height](const WallID w) {
+            const auto [p1, p2] = unrankWall(width, height, w);
+            return std::make_pair(rankCell(p1.first.first, p1.first.second), rankCell(p2.first.first, p2.first.second));
+        };
+
+        // The root of the component containing each cell, and the roots themselves.
+        std::vector<int> component(numCells);
+        std::iota(component.begin(), component.end(), 0);
+        std::vector<int> roots{component};
+
+        std::vector<std::atomic<std::uint64_t>> lightest(numCells);
+        std::vector<int> next(numCells);
+        std::vector<int> jump(numCells);
+        std::vector<char> carved(numWalls, false);
+
+        std::vector<WallID> walls(numWalls);
+        std::iota(walls.begin(), walls.end(), 0);
+        std::vector<std::vector<WallID>> wallBuffers(threads);
+
+        while (!walls.empty()) {
+            types::parallelFor(0, static_cast<int>(roots.size()), threads, [&](int, int begin, int end) {
+                for (auto i = begin; i < end; ++i)
+                    lightest[roots[i]].store(NoWall, std::memory_order_relaxed);
+            });
+
+            // Every component finds the lightest wall leading out of it.
+            types::parallelFor(0, static_cast<int>(walls.size()), threads, [&](int, int begin, int end) {
+                for (auto i = begin; i < end; ++i) {
+                    const auto w = walls[i];
+                    const auto [c1, c2] = wallCells(w);
+                    const auto wt = weight(w);
+                    for (const auto c: {component[c1], component[c2]}) {
+                        auto cur = lightest[c].load(std::memory_order_relaxed);
+                        while (wt < cur && !lightest[c].compare_exchange_weak(cur, wt, std::memory_order_relaxed));
+                    }
+                }
+            });
+
+            // Every component hooks itself onto the component across its lightest wall and carves it. If two
+            // components chose the same wall, only the one with the larger root hooks, so that no cycles form.
+            types::parallelFor(0, static_cast<int>(roots.size()), threads, [&](int, int begin, int end) {
+                for (auto i = begin; i < end; ++i) {
+                    const auto r = roots[i];
+                    const auto wt = lightest[r].load(std::memory_order_relaxed);
+                    next[r] = r;
+                    if (wt == NoWall) continue;
+
+                    const auto w = static_cast<WallID>(wt & idMask);
+                    const auto [c1, c2] = wallCells(w);
+                    const auto other = component[c1] == r ? component[c2] : component[c1];
+                    if (r < other && lightest[other].load(std::memory_order_relaxed) == wt) continue;
+                    next[r] = other;
+                    carved[w] = true;
+                }
+            });
+
+            // Find the new root of every component by pointer jumping.
+            for (std::atomic<bool> changed{true}; changed;) {
+                changed = false;
+                types::parallelFor(0, static_cast<int>(roots.size()), threads, [&](int, int begin, int end) {
+                    for (auto i = begin; i < end; ++i) {
+                        const auto r = roots[i];
+                        jump[r] = next[next[r]];
+                        if (jump[r] != next[r])
+                            changed = true;
+                    }
+                });
+                types::parallelFor(0, static_cast<int>(roots.size()), threads, [&](int, int begin, int end) {
+                    for (auto i = begin; i < end; ++i)
+                        next[roots[i]] = jump[roots[i]];
+                });
+            }
+
+            types::parallelFor(0, numCells, threads, [&](int, int begin, int end) {
+                for (auto i = begin; i < end; ++i)
+                    component[i] = next[component[i]];
+            });
+            roots.erase(std::remove_if(roots.begin(), roots.end(), [&next](int r) { return next[r] != r; }),
+                        roots.end());
+
+            // Discard the walls that now lie within a component. Each block appends to a buffer of its own.
+            const auto numBlocks = types::parallelFor(0, static_cast<int>(walls.size()), threads,
+                                                      [&](int block, int begin, int end) {
+                auto &buffer = wallBuffers[block];
+                buffer.clear();
+                for (auto i = begin; i < end; ++i) {
+                    const auto [c1, c2] = wallCells(walls[i]);
+                    if (component[c1] != component[c2])
+                        buffer.emplace_back(walls[i]);
+                }
+            });
+            walls.clear();
+            for (auto block = 0u; block < numBlocks; ++block)
+                walls.insert(walls.end(), wallBuffers[block].cbegin(), wallBuffers[block].cend());
+        }
+
+        WallIncidence wi(numWalls);
+        for (auto w = 0; w < numWalls; ++w)
+            wi[w] = !carved[w];
+        return Maze(getDimensions(), wi);
+    }
+}
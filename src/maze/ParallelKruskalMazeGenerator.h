@@ -0,0 +1,48 @@
+/**
+ * ParallelKruskalMazeGenerator.h
+ *
+ * By Sebastian Raaphorst, 2018.
+ *
+ * A maze generator producing the same distribution of mazes as the randomized Kruskal algorithm, using
+ * <a href="https://en.wikipedia.org/wiki/Bor%C5%AFvka%27s_algorithm">Borůvka's algorithm</a> across multiple threads.
+ */
+
+#pragma once
+
+#include <cstdint>
+
+#include <types/Dimensions2D.h>
+
+#include "MazeGenerator.h"
+
+namespace spelunker::maze {
+    class Maze;
+
+    /**
+     * A @see{MazeGenerator} that computes the minimum spanning tree of the grid with random wall weights.
+     *
+     * Randomized Kruskal processes the walls in a uniformly random order, which amounts to finding the minimum
+     * spanning tree for independent, uniformly random wall weights. Since that tree is unique, any minimum spanning
+     * tree algorithm produces the same distribution of mazes. Borůvka's algorithm parallelizes well: in each round,
+     * every component concurrently finds its lightest wall leading out of it, and these walls are all carved at once,
+     * at least halving the number of components.
+     *
+     * The weight of each wall is drawn from a @see{math::CounterRNG}, with the ID of the wall as its counter.
+     */
+    class ParallelKruskalMazeGenerator final : public MazeGenerator {
+    public:
+        ParallelKruskalMazeGenerator(const types::Dimensions2D &d, unsigned int numThreads = 0);
+        ParallelKruskalMazeGenerator(int w, int h, unsigned int numThreads = 0);
+        ~ParallelKruskalMazeGenerator() final = default;
+
+        /// Generate a maze, seeding the wall weights from @see{math::RNG}.
+        const Maze generate() const noexcept final;
+
+        /// Generate the maze for the given seed.
+        const Maze generate(std::uint64_t seed) const noexcept;
+
+    private:
+        /// The number of threads to use (0 meaning one per hardware thread).
+        const unsigned int numThreads;
+    };
+}
@@ -0,0 +1,155 @@
+/**
+ * ParallelRecursiveDivisionMazeGenerator.cpp
+ *
+ * By Sebastian Raaphorst, 2018.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <utility>
+#include <vector>
+
+#include <types/BitUtils.h>
+#include <types/Dimensions2D.h>
+#include <types/Parallel.h>
+#include <math/CounterRNG.h>
+
+#include "Maze.h"
+#include "MazeAttributes.h"
+#include "MazeGenerator.h"
+#include "ParallelRecursiveDivisionMazeGenerator.h"
+
+namespace spelunker::maze {
+    namespace {
+        /// An area to divide, with the stream from which its random values are drawn.
+        struct Area final {
+            int x, y, w, h;
+            std::uint64_t stream;
+        };
+
+        /// Wall bit planes that can be written concurrently: see @see{WallBitPlanes}.
+        class AtomicWallBitPlanes final {
+        public:
+            AtomicWallBitPlanes(const int width, const int height)
+                : rowWords{types::numWords(width)},
+                  east(static_cast<size_t>(rowWords) * height),
+                  south(static_cast<size_t>(rowWords) * height) {}
+
+            /// Add the walls to the east of the cells (x, y) for y in [y0, y1), except at the gap.
+            void addEastWalls(const int x, const int y0, const int y1, const int gap) noexcept {
+                const auto bit = std::uint64_t{1} << static_cast<unsigned int>(x % types::WordBits);
+                for (auto y = y0; y < y1; ++y)
+                    if (y != gap)
+                        east[y * rowWords + x / types::WordBits].fetch_or(bit, std::memory_order_relaxed);
+            }
+
+            /// Add the walls to the south of the cells (x, y) for x in [x0, x1), except at the gap, a word at a time.
+            void addSouthWalls(const int y, const int x0, const int x1, const int gap) noexcept {
+                for (auto x = x0; x < x1;) {
+                    const auto w = x / types::WordBits;
+                    const auto end = std::min(x1, (w + 1) * types::WordBits);
+                    auto mask = lowBits(end - w * types::WordBits) & ~lowBits(x - w * types::WordBits);
+                    if (x <= gap && gap < end)
+                        mask &= ~(std::uint64_t{1} << static_cast<unsigned int>(gap % types::WordBits));
+                    south[y * rowWords + w].fetch_or(mask, std::memory_order_relaxed);
+                    x = end;
+                }
+            }
+
+            /// Copy the planes once all of the walls have been added.
+            WallBitPlanes toWallBitPlanes(const int width, const int height) const {
+                WallBitPlanes planes{width, height};
+                for (size_t i = 0; i < east.size(); ++i) {
+                    planes.east[i] = east[i].load(std::memory_order_relaxed);
+                    planes.south[i] = south[i].load(std::memory_order_relaxed);
+                }
+                return planes;
+            }
+
+        private:
+            static std::uint64_t lowBits(const int n) noexcept {
+                return n >= types::WordBits ? ~std::uint64_t{0} : (std::uint64_t{1} << static_cast<unsigned int>(n)) - 1;
+            }
+
+            const int rowWords;
+
+            // Value-initialized, so every word starts out as zero, i.e. with no walls.
+            std::vector<std::atomic<std::uint64_t>> east;
+            std::vector<std::atomic<std::uint64_t>> south;
+        };
+    }
+
+    ParallelRecursiveDivisionMazeGenerator::ParallelRecursiveDivisionMazeGenerator(const types::Dimensions2D &d,
+                                                                                   const unsigned int numThreads)
+        : MazeGenerator{d}, numThreads{numThreads} {}
+
+    ParallelRecursiveDivisionMazeGenerator::ParallelRecursiveDivisionMazeGenerator(const int w, const int h,
+                                                                                   const unsigned int numThreads)
+        : ParallelRecursiveDivisionMazeGenerator{types::Dimensions2D{w, h}, numThreads} {}
+
+    const Maze ParallelRecursiveDivisionMazeGenerator::generate() const noexcept {
+        return generate(math::CounterRNG::fromRNG().getSeed());
+    }
+
+    const Maze ParallelRecursiveDivisionMazeGenerator::generate(const std::uint64_t seed) const noexcept {
+        const auto [width, height] = getDimensions().values();
+        const math::CounterRNG rng{seed};
+
+        // Unlike other algorithms, we start with no walls, and then add them.
+        AtomicWallBitPlanes planes{width, height};
+
+        // Divide an area as RecursiveDivisionMazeGenerator does, returning the two subareas.
+        const auto divide = [&rng, &planes](const Area &area) {
+            // Split in the direction that will result in the closest w:h ratio.
+            const auto vertical = (area.h == 1) || (area.w > area.h);
+            const auto p = rng.range(area.stream, 0, (vertical ? area.w : area.h) - 1);
+            const auto gap = rng.range(area.stream, 1, vertical ? area.h : area.w);
+
+            // The subareas draw from streams of their own, derived from this one.
+            const auto stream1 = math::mix64(area.stream ^ 0x2545f4914f6cdd1dull);
+            const auto stream2 = math::mix64(area.stream ^ 0x9e3779b97f4a7c15ull);
+
+            if (vertical) {
+                planes.addEastWalls(area.x + p, area.y, area.y + area.h, area.y + gap);
+                return std::make_pair(Area{area.x, area.y, p + 1, area.h, stream1},
+                                      Area{area.x + p + 1, area.y, area.w - p - 1, area.h, stream2});
+            }
+            planes.addSouthWalls(area.y + p, area.x, area.x + area.w, area.x + gap);
+            return std::make_pair(Area{area.x, area.y, area.w, p + 1, stream1},
+                                  Area{area.x, area.y + p + 1, area.w, area.h - p - 1, stream2});
+        };
+
+        // Divide an area completely within the current task.
+        const auto divideAll = [&divide](const Area &area) {
+            std::vector<Area> areas{area};
+            while (!areas.empty()) {
+                const auto a = areas.back();
+                areas.pop_back();
+                if (a.w == 1 && a.h == 1)
+                    continue;
+                const auto [a1, a2] = divide(a);
+                areas.emplace_back(a2);
+                areas.emplace_back(a1);
+            }
+        };
+
+        {
+            types::TaskGroup tasks{numThreads};
+            std::function<void(const Area&)> divideTask = [&](const Area &area) {
+                if (static_cast<long long>(area.w) * area.h < taskCutoff) {
+                    divideAll(area);
+                    return;
+                }
+                const auto [a1, a2] = divide(area);
+                tasks.run([&divideTask, a2] { divideTask(a2); });
+                divideTask(a1);
+            };
+            divideTask(Area{0, 0, width, height, rng(0)});
+            tasks.wait();
+        }
+
+        return Maze(getDimensions(), createMazeLayout(planes.toWallBitPlanes(width, height)));
+    }
+}
@@ -0,0 +1,50 @@
+/**
+ * ParallelRecursiveDivisionMazeGenerator.h
+ *
+ * By Sebastian Raaphorst, 2018.
+ *
+ * A maze generator using recursive division, dividing the subareas concurrently.
+ */
+
+#pragma once
+
+#include <cstdint>
+
+#include <types/Dimensions2D.h>
+
+#include "MazeGenerator.h"
+
+namespace spelunker::maze {
+    class Maze;
+
+    /**
+     * A @see{MazeGenerator} producing the same distribution of mazes as @see{RecursiveDivisionMazeGenerator}.
+     *
+     * The two areas produced by dividing an area are independent, so large areas are divided as separate tasks run by a
+     * @see{types::TaskGroup}, while areas smaller than a cutoff are divided entirely within a single task. Since the
+     * areas are disjoint, the tasks write their walls into shared bit planes without locking, by atomically or-ing
+     * whole words of walls at a time.
+     *
+     * The random values for each area are drawn from a @see{math::CounterRNG} with a stream derived from the stream of
+     * the area it was divided from, so the maze does not depend upon the order in which the tasks are run.
+     */
+    class ParallelRecursiveDivisionMazeGenerator final : public MazeGenerator {
+    public:
+        ParallelRecursiveDivisionMazeGenerator(const types::Dimensions2D &d, unsigned int numThreads = 0);
+        ParallelRecursiveDivisionMazeGenerator(int w, int h, unsigned int numThreads = 0);
+        ~ParallelRecursiveDivisionMazeGenerator() final = default;
+
+        /// Generate a maze, seeding the divisions from @see{math::RNG}.
+        const Maze generate() const noexcept final;
+
+        /// Generate the maze for the given seed.
+        const Maze generate(std::uint64_t seed) const noexcept;
+
+        /// Areas with fewer cells than this are divided within a single task.
+        static constexpr int taskCutoff = 1 << 14;
+
+    private:
+        /// The number of threads to use (0 meaning one per hardware thread).
+        const unsigned int numThreads;
+    };
+}
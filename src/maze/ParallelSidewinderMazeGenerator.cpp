@@ -0,0 +1,91 @@
+/**
+ * ParallelSidewinderMazeGenerator.cpp
+ *
+ * By Sebastian Raaphorst, 2018.
+ */
+
+#include <cstdint>
+
+#include <types/BitUtils.h>
+#include <types/Dimensions2D.h>
+#include <types/Parallel.h>
+#include <math/CounterRNG.h>
+#include <math/MathUtils.h>
+
+#include "Maze.h"
+#include "MazeAttributes.h"
+#include "MazeGenerator.h"
+#include "ParallelSidewinderMazeGenerator.h"
+
+namespace spelunker::maze {
+    ParallelSidewinderMazeGenerator::ParallelSidewinderMazeGenerator(const types::Dimensions2D &d,
+                                                                     const double p,
+                                                                     const unsigned int numThreads)
+        : MazeGenerator{d}, probabilityEast{p}, numThreads{numThreads} {
+        math::MathUtils::checkProbability(p);
+    }
+
+    ParallelSidewinderMazeGenerator::ParallelSidewinderMazeGenerator(const int w, const int h, const double p,
+                                                                     const unsigned int numThreads)
+        : ParallelSidewinderMazeGenerator{types::Dimensions2D{w, h}, p, numThreads} {}
+
+    ParallelSidewinderMazeGenerator::ParallelSidewinderMazeGenerator(const types::Dimensions2D &d)
+        : ParallelSidewinderMazeGenerator{d, defaultProbabilityEast} {}
+
+    ParallelSidewinderMazeGenerator::ParallelSidewinderMazeGenerator(const int w, const int h)
+        : ParallelSidewinderMazeGenerator{types::Dimensions2D{w, h}, defaultProbabilityEast} {}
+
+    const Maze ParallelSidewinderMazeGenerator::generate() const noexcept {
+        return generate(math::CounterRNG::fromRNG().getSeed());
+    }
+
+    const Maze ParallelSidewinderMazeGenerator::generate(const std::uint64_t seed) const noexcept {
+        const auto [width, height] = getDimensions().values();
+        const math::CounterRNG rng{seed};
+        WallBitPlanes planes{width, height};
+
+        // The run always ends at the easternmost cell.
+        const auto lastWord = (width - 1) / types::WordBits;
+        const auto lastBit = std::uint64_t{1} << static_cast<unsigned int>((width - 1) % types::WordBits);
+
+        // The counters used by bernoulliWord for the run ends, after which come the counters for the cells carving south.
+        const auto runCounters = static_cast<std::uint64_t>(32) * planes.rowWords;
+
+        types::parallelFor(0, height, numThreads, [&](int, int begin, int end) {
+            for (auto y = begin; y < end; ++y) {
+                auto east = planes.eastRow(y);
+                auto south = planes.southRow(y);
+                const auto stream = static_cast<std::uint64_t>(y);
+
+                // The bottom row is all empty.
+                if (y == height - 1) {
+                    for (auto w = 0; w < planes.rowWords; ++w)
+                        east[w] = 0;
+                    continue;
+                }
+
+                for (auto w = 0; w < planes.rowWords; ++w) {
+                    east[w] = rng.bernoulliWord(stream, w, 1 - probabilityEast);
+                    if (w == lastWord) {
+                        east[w] |= lastBit;
+                        break;
+                    }
+                }
+
+                // Scan for the ends of the runs, and carve south from a random cell in each.
+                auto runStart = 0;
+                for (auto w = 0; w <= lastWord; ++w)
+                    for (auto ends = east[w]; ends; ends &= ends - 1) {
+                        const auto runEnd = w * types::WordBits + types::countTrailingZeros(ends);
+                        if (runEnd >= width)
+                            break;
+                        const auto x = runStart + rng.range(stream, runCounters + runEnd, runEnd - runStart + 1);
+                        types::clearBit(south, x);
+                        runStart = runEnd + 1;
+                    }
+            }
+        });
+
+        return Maze(getDimensions(), createMazeLayout(planes));
+    }
+}
@@ -0,0 +1,53 @@
+/**
+ * ParallelSidewinderMazeGenerator.h
+ *
+ * By Sebastian Raaphorst, 2018.
+ *
+ * A maze generator using the sidewinder algorithm on 64 cells at a time, across multiple threads.
+ */
+
+#pragma once
+
+#include <cstdint>
+
+#include <types/Dimensions2D.h>
+
+#include "MazeGenerator.h"
+
+namespace spelunker::maze {
+    class Maze;
+
+    /**
+     * A @see{MazeGenerator} producing the same distribution of mazes as @see{SidewinderMazeGenerator}.
+     *
+     * The rows of a sidewinder maze are independent of each other. In each row, the cells where a run ends are given by
+     * a word of random bits, each set with probability 1-p, per 64 cells: these are exactly the cells with a wall to
+     * their east. The runs are then found by scanning for the set bits, and a random cell of each carves south. The
+     * words are written directly into the @see{WallBitPlanes} of the maze, with the rows divided amongst the threads.
+     *
+     * The random values are drawn from a @see{math::CounterRNG} with a stream per row, so the maze for a seed can also
+     * be queried without being generated through @see{VirtualSidewinderMaze}.
+     */
+    class ParallelSidewinderMazeGenerator final : public MazeGenerator {
+    public:
+        ParallelSidewinderMazeGenerator(const types::Dimensions2D &d, double p, unsigned int numThreads = 0);
+        ParallelSidewinderMazeGenerator(int w, int h, double p, unsigned int numThreads = 0);
+        ParallelSidewinderMazeGenerator(const types::Dimensions2D &d);
+        ParallelSidewinderMazeGenerator(int w, int h);
+        ~ParallelSidewinderMazeGenerator() final = default;
+
+        /// Generate a maze, seeding the rows from @see{math::RNG}.
+        const Maze generate() const noexcept final;
+
+        /// Generate the maze for the given seed.
+        const Maze generate(std::uint64_t seed) const noexcept;
+
+        static constexpr double defaultProbabilityEast = 0.5;
+
+    private:
+        const double probabilityEast;
+
+        /// The number of threads to use (0 meaning one per hardware thread).
+        const unsigned int numThreads;
+    };
+}
@@ -4,6 +4,9 @@
  * By Sebastian Raaphorst, 2018.
  */
 
+#include <cstdint>
+#include <memory>
+
 #include <types/CommonMazeAttributes.h>
 #include <types/Dimensions2D.h>
 #include <types/Direction.h>
@@ -21,54 +24,82 @@ namespace spelunker::maze {
     PrimMazeGenerator::PrimMazeGenerator(int w, int h)
         : PrimMazeGenerator{types::Dimensions2D{w, h}} {}
 
-    const Maze PrimMazeGenerator::generate() const noexcept {
-        const auto [width, height] = getDimensions().values();
+    class PrimMazeGenerator::Stepper final : public MazeStepper {
+    public:
+        explicit Stepper(const PrimMazeGenerator &g)
+            : MazeStepper{g.getDimensions()},
+              gen{g},
+              wi(createMazeLayout(g.getDimensions(), true)),
+              ci(types::initializeCellIndicator(g.getDimensions(), false)) {
+            // Pick a cell at random.
+            const int startX = math::RNG::randomRange(g.getWidth());
+            const int startY = math::RNG::randomRange(g.getHeight());
+
+            // Add the walls of the start cell to the wall list, and mark the start cell as visited.
+            gen.addCellWalls(types::cell(startX, startY), walls, wi);
+            ci[startX][startY] = true;
+        }
+
+        bool isDone() const noexcept final {
+            return walls.empty();
+        }
+
+        const Maze current() const final {
+            return Maze(getDimensions(), wi);
+        }
+
+    protected:
+        std::uint64_t run(const std::uint64_t maxSteps) final {
+            std::uint64_t steps = 0;
+            for (; steps < maxSteps && !walls.empty(); ++steps) {
+                // Pick a random wall from the list.
+                // We swap it with the end element and remove that for efficiency.
+                const auto wallIdx = math::RNG::randomRange(walls.size());
+                std::swap(walls[wallIdx], walls.back());
+                const auto wallID = walls.back();
+                walls.pop_back();
+
+                // This wall divides two cells: at most one of them will be unvisited.
+                const auto [p1, p2] = gen.unrankWallID(wallID);
+                const auto &cell1 = p1.first;
+                const auto &cell2 = p2.first;
+
+                const auto cell1Visited = ci[cell1.first][cell1.second];
+                const auto cell2Visited = ci[cell2.first][cell2.second];
+
+                if (cell1Visited && cell2Visited)
+                    continue;
+                const auto &unvisitedCell = cell1Visited ? cell2 : cell1;
+
+                // Remove this wall, mark the cell as visited, and add its walls to the list.
+                wi[wallID] = false;
+                ci[unvisitedCell.first][unvisitedCell.second] = true;
+                gen.addCellWalls(unvisitedCell, walls, wi);
+            }
+            return steps;
+        }
+
+    private:
+        const PrimMazeGenerator gen;
 
         // We start with all walls, and then remove them iteratively.
-        auto wi = createMazeLayout(getDimensions(), true);
+        WallIncidence wi;
 
         // We need a cell lookup to check if we have visited a cell already.
-        auto ci = types::initializeCellIndicator(getDimensions(), false);
+        types::CellIndicator ci;
 
-        // Pick a cell at random.
-        const int startX = math::RNG::randomRange(width);
-        const int startY = math::RNG::randomRange(height);
-
-        // Create a wall list, add the walls of the start cell to it, and mark
-        // the start cell as visited.
+        // The walls between the visited cells and the unvisited ones, amongst others.
         WallCollection walls;
-        addCellWalls(types::cell(startX, startY), walls, wi);
-        ci[startX][startY] = true;
-        // We also need to be able to unrank walls.
-        auto unrank = createUnrankWallMap();
-
-        while (!walls.empty()) {
-            // Pick a random wall from the list.
-            // We swap it with the end element and remove that for efficiency.
-            const auto wallIdx = math::RNG::randomRange(walls.size());
-            std::swap(walls[wallIdx], walls.back());
-            const auto wallID = walls.back();
-            walls.pop_back();
-
-            // This wall divides two cells: at most one of them will be unvisited.
-            const auto  cells = unrank[wallID];
-            const auto &cell1 = cells.first.first;
-            const auto &cell2 = cells.second.first;
-
-            const auto cell1Visited = ci[cell1.first][cell1.second];
-            const auto cell2Visited = ci[cell2.first][cell2.second];
-
-            if (cell1Visited && cell2Visited)
-                continue;
-            const auto &unvisitedCell = cell1Visited ? cell2 : cell1;
-
-            // Remove this wall, mark the cell as visited, and add its walls to the list.
-            wi[wallID] = false;
-            ci[unvisitedCell.first][unvisitedCell.second] = true;
-            addCellWalls(unvisitedCell, walls, wi);
-        }
+    };
+
+    const Maze PrimMazeGenerator::generate() const noexcept {
+        Stepper stepper{*this};
+        stepper.finish();
+        return stepper.current();
+    }
 
-        return Maze(getDimensions(), wi);
+    std::unique_ptr<MazeStepper> PrimMazeGenerator::stepper() const {
+        return std::make_unique<Stepper>(*this);
     }
 
     void PrimMazeGenerator::addCellWalls(const types::Cell &c,
@@ -10,6 +10,8 @@
 
 #pragma once
 
+#include <memory>
+
 #include <types/CommonMazeAttributes.h>
 #include <types/Dimensions2D.h>
 
@@ -28,7 +30,15 @@ namespace spelunker::maze {
 
         const Maze generate() const noexcept final;
 
+        /**
+         * Begin a generation that can be advanced a bounded number of steps at a time, which produces the same
+         * mazes as @see{generate}. A step is the removal of a wall from the wall list.
+         */
+        std::unique_ptr<MazeStepper> stepper() const;
+
     private:
+        class Stepper;
+
         /// Add the non-exterior walls of a cell to the wall list, with one possible omission.
         void addCellWalls(const types::Cell &c, WallCollection &wallList, const WallIncidence &wi) const noexcept;
     };
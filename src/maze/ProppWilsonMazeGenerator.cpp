@@ -0,0 +1,152 @@
+/**
+ * ProppWilsonMazeGenerator.cpp
+ *
+ * By Sebastian Raaphorst, 2018.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <limits>
+#include <thread>
+#include <vector>
+
+#include <types/CommonMazeAttributes.h>
+#include <types/Dimensions2D.h>
+#include <types/Direction.h>
+#include <types/Parallel.h>
+#include <math/CounterRNG.h>
+
+#include "Maze.h"
+#include "MazeAttributes.h"
+#include "MazeGenerator.h"
+#include "ProppWilsonMazeGenerator.h"
+
+namespace spelunker::maze {
+    ProppWilsonMazeGenerator::ProppWilsonMazeGenerator(const types::Dimensions2D &d, const unsigned int numThreads)
+        : MazeGenerator{d}, numThreads{numThreads} {}
+
+    ProppWilsonMazeGenerator::ProppWilsonMazeGenerator(const int w, const int h, const unsigned int numThreads)
+        : ProppWilsonMazeGenerator{types::Dimensions2D{w, h}, numThreads} {}
+
+    const Maze ProppWilsonMazeGenerator::generate() const noexcept {
+        return generate(math::CounterRNG::fromRNG().getSeed());
+    }
+
+    const Maze ProppWilsonMazeGenerator::generate(const std::uint64_t seed) const noexcept {
+        const auto [width, height] = getDimensions().values();
+        const auto numCells = width * height;
+        const auto threads = numThreads == 0 ? types::defaultNumThreads() : numThreads;
+        const math::CounterRNG rng{seed};
+
+        // The root is drawn from a stream of its own: the stream of each cell is its rank.
+        const auto root = rng.range(std::numeric_limits<std::uint64_t>::max(), 0, numCells);
+
+        // The arrow at the given depth of the stack of a cell, chosen amongst its neighbours in the order west, north,
+        // east, south.
+        const auto arrow = [this, &rng, width](const int c, const std::uint32_t depth) {
+            types::Direction dirs[4];
+            const auto numDirs = neighbourDirections(c % width, c / width, dirs);
+            return dirs[rng.range(static_cast<std::uint64_t>(c), depth, numDirs)];
+        };
+        const auto follow = [width](const int c, const types::Direction d) {
+            switch (d) {
+                case types::Direction::NORTH: return c - width;
+                case types::Direction::EAST:  return c + 1;
+                case types::Direction::SOUTH: return c + width;
+                case types::Direction::WEST:  return c - 1;
+            }
+            return c;
+        };
+
+        // The owner of each cell: the thread whose walk currently contains it, or Free, or Settled if its arrows
+        // lead to the root. Only the owner of a cell may pop its stack.
+        constexpr int Free = -1;
+        constexpr int Settled = -2;
+        std::vector<std::atomic<int>> owner(numCells);
+        for (auto &o: owner)
+            o.store(Free, std::memory_order_relaxed);
+        owner[root].store(Settled, std::memory_order_relaxed);
+
+        // The depth of the top of the stack of each cell, its top arrow, and its position in its owner's walk.
+        std::vector<std::uint32_t> depths(numCells, 0);
+        std::vector<types::Direction> arrows(numCells, types::Direction::NORTH);
+        std::vector<int> walkIndices(numCells, 0);
+
+        // Follow the top arrows from start, popping every cycle closed by the walk, until a settled cell is reached
+        // and the walk is settled. This is exactly Wilson's loop-erased random walk. If the walk runs into the walk of
+        // another thread, the thread with the lower ID gives its walk up and returns false, and the other waits for it
+        // to do so, so that walks never wait upon each other in a cycle.
+        const auto walk = [&](const int start, const int t, std::vector<int> &path) {
+            path.clear();
+            path.emplace_back(start);
+            walkIndices[start] = 0;
+
+            for (;;) {
+                const auto c = path.back();
+                arrows[c] = arrow(c, depths[c]);
+                const auto nxt = follow(c, arrows[c]);
+                auto o = owner[nxt].load(std::memory_order_acquire);
+
+                if (o == Settled) {
+                    for (const auto p: path)
+                        owner[p].store(Settled, std::memory_order_release);
+                    return true;
+                }
+                if (o == t) {
+                    // Pop the cycle, and continue the walk from where it closed.
+                    const auto idx = walkIndices[nxt];
+                    for (auto i = idx; i < static_cast<int>(path.size()); ++i)
+                        ++depths[path[i]];
+                    for (auto i = idx + 1; i < static_cast<int>(path.size()); ++i)
+                        owner[path[i]].store(Free, std::memory_order_release);
+                    path.resize(idx + 1);
+                }
+                else if (o == Free) {
+                    if (owner[nxt].compare_exchange_strong(o, t, std::memory_order_acq_rel)) {
+                        walkIndices[nxt] = static_cast<int>(path.size());
+                        path.emplace_back(nxt);
+                    }
+                }
+                else if (t > o)
+                    std::this_thread::yield();
+                else {
+                    for (const auto p: path)
+                        owner[p].store(Free, std::memory_order_release);
+                    return false;
+                }
+            }
+        };
+
+        // Every thread starts walks from the cells of its block. A walk that is given up is restarted, and a cell whose
+        // walk is given up by another thread is picked up in a final sequential pass.
+        types::parallelFor(0, numCells, threads, [&](int block, int begin, int end) {
+            const auto t = static_cast<int>(block);
+            std::vector<int> path;
+            for (auto start = begin; start < end; ++start)
+                for (;;) {
+                    auto o = Free;
+                    if (!owner[start].compare_exchange_strong(o, t, std::memory_order_acq_rel) ||
+                        walk(start, t, path))
+                        break;
+                    std::this_thread::yield();
+                }
+        });
+
+        std::vector<int> path;
+        for (auto start = 0; start < numCells; ++start)
+            if (owner[start].load(std::memory_order_relaxed) == Free) {
+                owner[start].store(0, std::memory_order_relaxed);
+                walk(start, 0, path);
+            }
+
+        // The arrows now form a spanning tree directed towards the root.
+        auto wi = createMazeLayout(getDimensions(), true);
+        for (auto c = 0; c < numCells; ++c)
+            if (c != root) {
+                const auto [x, y] = unrankCell(c);
+                wi[rankPos(types::pos(x, y, arrows[c]))] = false;
+            }
+        return Maze(getDimensions(), wi);
+    }
+}
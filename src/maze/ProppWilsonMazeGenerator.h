@@ -0,0 +1,54 @@
+/**
+ * ProppWilsonMazeGenerator.h
+ *
+ * By Sebastian Raaphorst, 2018.
+ *
+ * A maze generator producing uniform spanning trees, as Wilson's algorithm does, by
+ * <a href="https://doi.org/10.1006/jagm.1997.0917">cycle popping</a> across multiple threads.
+ */
+
+#pragma once
+
+#include <cstdint>
+
+#include <types/Dimensions2D.h>
+
+#include "MazeGenerator.h"
+
+namespace spelunker::maze {
+    class Maze;
+
+    /**
+     * A @see{MazeGenerator} that samples a uniform spanning tree using the cycle popping formulation of Wilson's
+     * algorithm due to Propp and Wilson.
+     *
+     * A root cell is chosen, and every other cell is given an infinite stack of random arrows, each pointing to one of
+     * its neighbours. The top arrows of the stacks form a graph in which every cell leads either to the root or into a
+     * cycle. While there are cycles, pop them, exposing the next arrow on the stack of every cell on a cycle. When none
+     * remain, the top arrows form a spanning tree directed towards the root, and its passages are carved.
+     *
+     * The set of cycles popped, and hence the tree, does not depend upon the order in which they are popped. Wilson's
+     * loop-erased random walk is one such order, and threads can pop cycles concurrently: each thread walks from the
+     * cells of its own block along the top arrows, claiming the cells it passes through, popping any cycle its walk
+     * closes, and settling its walk when it reaches a cell whose arrows lead to the root.
+     *
+     * The arrow at each depth of each stack is drawn from a @see{math::CounterRNG}, with the cell as its stream and
+     * the depth as its counter.
+     */
+    class ProppWilsonMazeGenerator final : public MazeGenerator {
+    public:
+        ProppWilsonMazeGenerator(const types::Dimensions2D &d, unsigned int numThreads = 0);
+        ProppWilsonMazeGenerator(int w, int h, unsigned int numThreads = 0);
+        ~ProppWilsonMazeGenerator() final = default;
+
+        /// Generate a maze, seeding the arrow stacks from @see{math::RNG}.
+        const Maze generate() const noexcept final;
+
+        /// Generate the maze for the given seed.
+        const Maze generate(std::uint64_t seed) const noexcept;
+
+    private:
+        /// The number of threads to use (0 meaning one per hardware thread).
+        const unsigned int numThreads;
+    };
+}
@@ -14,6 +14,7 @@
 #include <types/Direction.h>
 #include <maze/Maze.h>
 #include <maze/MazeAttributes.h>
+#include <maze/VirtualMaze.h>
 
 #include "StringMazeRenderer.h"
 
@@ -28,7 +29,22 @@ namespace spelunker::maze {
         return m.wall(x, y, d);
     }
 
+    bool StringMazeRenderer::wall(const VirtualMaze &m, int x, int y, types::Direction d) {
+        if (x < 0 || x >= m.getWidth())  return false;
+        if (y < 0 || y >= m.getHeight()) return false;
+        return m.wall(x, y, d);
+    }
+
     void StringMazeRenderer::render(const spelunker::maze::Maze &m) {
+        renderMaze(m);
+    }
+
+    void StringMazeRenderer::render(const VirtualMaze &m) {
+        renderMaze(m);
+    }
+
+    template<typename M>
+    void StringMazeRenderer::renderMaze(const M &m) {
         /**
          * First, we have to convert the Maze from an x by y grid into an (x+1) by (y+1) box drawing.
          * To determine cell (x,y) in the box drawing, we need the following cells from the Maze:
@@ -20,6 +20,7 @@
 
 namespace spelunker::maze {
     class Maze;
+    class VirtualMaze;
 
     /// A simple maze renderer to an ostream. We use this to define the Show type class for Maze.
     /**
@@ -33,11 +34,19 @@ namespace spelunker::maze {
 
         void render(const Maze &m) override;
 
+        /// Render a maze whose walls are computed on demand. Note that every cell is visited.
+        void render(const VirtualMaze &m);
+
     private:
         std::ostream &out;
 
         /// A quick and dirty extractor to get a wall status from a Maze, returning false for illegal coordinates.
         static bool wall(const Maze &m, int x, int y, types::Direction d);
+        static bool wall(const VirtualMaze &m, int x, int y, types::Direction d);
+
+        /// Render any maze for which there is a wall extractor.
+        template<typename M>
+        void renderMaze(const M &m);
 
         /// The characters used in the box form of the maze representation. There has to be a better way to do this.
         static const std::vector<std::string> boxchars;
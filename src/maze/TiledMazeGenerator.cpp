@@ -0,0 +1,165 @@
+/**
+ * TiledMazeGenerator.cpp
+ *
+ * By Sebastian Raaphorst, 2018.
+ */
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include <types/BitUtils.h>
+#include <types/Dimensions2D.h>
+#include <types/Direction.h>
+#include <types/DisjointSets.h>
+#include <types/Parallel.h>
+#include <math/CounterRNG.h>
+#include <math/DefaultRNG.h>
+#include <math/RNG.h>
+
+#include "Maze.h"
+#include "MazeAttributes.h"
+#include "MazeGenerator.h"
+#include "TiledMazeGenerator.h"
+
+namespace spelunker::maze {
+    TiledMazeGenerator::TiledMazeGenerator(const types::Dimensions2D &d, const types::Dimensions2D &tileDimensions,
+                                           TileGeneratorFactory factory, const unsigned int numThreads)
+        : MazeGenerator{d}, tileDimensions{tileDimensions}, factory{std::move(factory)}, numThreads{numThreads} {
+        if (tileDimensions.getWidth() <= 0 || tileDimensions.getHeight() <= 0)
+            throw std::invalid_argument("Tile dimensions must be positive.");
+        if (!this->factory)
+            throw std::invalid_argument("A tile generator factory is required.");
+    }
+
+    TiledMazeGenerator::TiledMazeGenerator(const int w, const int h, const int tileWidth, const int tileHeight,
+                                           TileGeneratorFactory factory, const unsigned int numThreads)
+        : TiledMazeGenerator{types::Dimensions2D{w, h}, types::Dimensions2D{tileWidth, tileHeight},
+                             std::move(factory), numThreads} {}
+
+    const Maze TiledMazeGenerator::generate() const noexcept {
+        return generate(math::CounterRNG::fromRNG().getSeed());
+    }
+
+    const Maze TiledMazeGenerator::generate(const std::uint64_t seed) const noexcept {
+        const auto [width, height] = getDimensions().values();
+        const auto [tileWidth, tileHeight] = tileDimensions.values();
+        const auto numColumns = (width + tileWidth - 1) / tileWidth;
+        const auto numRows = (height + tileHeight - 1) / tileHeight;
+        const auto numTiles = numColumns * numRows;
+        const math::CounterRNG rng{seed};
+
+        const auto tileOf = [tileWidth, tileHeight, numColumns](const int x, const int y) {
+            return (y / tileHeight) * numColumns + x / tileWidth;
+        };
+
+        // Generate the tiles, labelling the cells of each tile by their connected component within the tile.
+        std::vector<std::unique_ptr<Maze>> tiles(numTiles);
+        std::vector<int> labels(width * height);
+        std::vector<int> numComponents(numTiles);
+        {
+            types::TaskGroup group{numThreads};
+            for (auto t = 0; t < numTiles; ++t)
+                group.run([&, t] {
+                    const auto column = t % numColumns;
+                    const auto row = t / numColumns;
+                    const auto x0 = column * tileWidth;
+                    const auto y0 = row * tileHeight;
+                    const auto tw = std::min(tileWidth, width - x0);
+                    const auto th = std::min(tileHeight, height - y0);
+
+                    // Generate the tile with an RNG of its own, restoring the RNG of the thread afterwards.
+                    {
+                        const math::RNG::ThreadRNGScope scope{std::make_shared<math::DefaultRNG>(rng(t))};
+                        const auto gen = factory(column, row, types::Dimensions2D{tw, th});
+                        tiles[t] = std::make_unique<Maze>(gen->generate());
+                    }
+
+                    const auto &tile = *tiles[t];
+                    types::DisjointSets dsets(tw * th);
+                    for (auto y = 0; y < th; ++y)
+                        for (auto x = 0; x < tw; ++x) {
+                            if (x + 1 < tw && !tile.wall(x, y, types::Direction::EAST))
+                                dsets.unite(y * tw + x, y * tw + x + 1);
+                            if (y + 1 < th && !tile.wall(x, y, types::Direction::SOUTH))
+                                dsets.unite(y * tw + x, (y + 1) * tw + x);
+                        }
+
+                    std::vector<int> componentOf(tw * th, -1);
+                    auto count = 0;
+                    for (auto y = 0; y < th; ++y)
+                        for (auto x = 0; x < tw; ++x) {
+                            auto &component = componentOf[dsets.find(y * tw + x)];
+                            if (component == -1)
+                                component = count++;
+                            labels[rankCell(x0 + x, y0 + y)] = component;
+                        }
+                    numComponents[t] = count;
+                });
+            group.wait();
+        }
+
+        // Copy the walls inside the tiles, with each thread responsible for whole rows of the planes.
+        WallBitPlanes planes{width, height};
+        types::parallelFor(0, height, numThreads, [&](int, int begin, int end) {
+            for (auto y = begin; y < end; ++y) {
+                auto east = planes.eastRow(y);
+                auto south = planes.southRow(y);
+                const auto ty = y % tileHeight;
+                for (auto x = 0; x < width; ++x) {
+                    const auto &tile = *tiles[tileOf(x, y)];
+                    const auto tx = x % tileWidth;
+                    if (tx + 1 < tile.getWidth() && !tile.wall(tx, ty, types::Direction::EAST))
+                        types::clearBit(east, x);
+                    if (ty + 1 < tile.getHeight() && !tile.wall(tx, ty, types::Direction::SOUTH))
+                        types::clearBit(south, x);
+                }
+            }
+        });
+        tiles.clear();
+
+        // Number the components of all the tiles consecutively.
+        std::vector<int> firstComponent(numTiles + 1, 0);
+        for (auto t = 0; t < numTiles; ++t)
+            firstComponent[t + 1] = firstComponent[t] + numComponents[t];
+        const auto component = [&](const int x, const int y) {
+            return firstComponent[tileOf(x, y)] + labels[rankCell(x, y)];
+        };
+
+        // Gather the walls along the tile boundaries: the east walls of the last column of each tile, and the south
+        // walls of the last row of each tile, each encoded as twice the rank of its cell, plus one if south.
+        std::vector<std::uint64_t> boundary;
+        for (auto y = 0; y < height; ++y)
+            for (auto x = tileWidth - 1; x + 1 < width; x += tileWidth)
+                boundary.emplace_back(2 * static_cast<std::uint64_t>(rankCell(x, y)));
+        for (auto y = tileHeight - 1; y + 1 < height; y += tileHeight)
+            for (auto x = 0; x < width; ++x)
+                boundary.emplace_back(2 * static_cast<std::uint64_t>(rankCell(x, y)) + 1);
+
+        // Shuffle them from a stream of their own, and open those joining different components.
+        constexpr auto boundaryStream = std::numeric_limits<std::uint64_t>::max();
+        const auto numBoundary = static_cast<int>(boundary.size());
+        for (auto i = numBoundary - 1; i > 0; --i)
+            std::swap(boundary[i], boundary[rng.range(boundaryStream, i, i + 1)]);
+
+        types::DisjointSets components(firstComponent[numTiles]);
+        for (auto i = 0; i < numBoundary && components.getNumSets() > 1; ++i) {
+            const auto rk = static_cast<int>(boundary[i] / 2);
+            const auto x = rk % width;
+            const auto y = rk / width;
+            if (boundary[i] % 2 == 0) {
+                if (components.unite(component(x, y), component(x + 1, y)))
+                    types::clearBit(planes.eastRow(y), x);
+            } else {
+                if (components.unite(component(x, y), component(x, y + 1)))
+                    types::clearBit(planes.southRow(y), x);
+            }
+        }
+
+        return Maze(getDimensions(), createMazeLayout(planes));
+    }
+}
@@ -0,0 +1,83 @@
+/**
+ * TiledMazeGenerator.h
+ *
+ * By Sebastian Raaphorst, 2018.
+ *
+ * A meta-generator that generates a maze as independent tiles, in parallel, and stitches them together.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+
+#include <types/Dimensions2D.h>
+
+#include "MazeGenerator.h"
+
+namespace spelunker::maze {
+    class Maze;
+
+    /**
+     * A @see{MazeGenerator} that splits the grid into tiles, generates each tile independently with any other
+     * generator, and then joins the tiles into a single maze.
+     *
+     * The tiles are generated concurrently, each by a generator created for it by a factory, so different tiles may
+     * use different algorithms. Each tile is generated with a @see{math::RNG} of its own, set for the thread generating
+     * it and seeded from the seed of the maze and the index of the tile, so that, as with @see{math::CounterRNG}, the
+     * maze does not depend upon which thread generates which tile.
+     *
+     * The tiles are then joined by considering the walls along the tile boundaries in a random order, and opening those
+     * that join two different connected components of the tiles, as in Kruskal's algorithm over the components rather
+     * than the cells. If the tiles are perfect mazes, the result is a perfect maze. The texture of each algorithm is
+     * kept within its tiles, but the joins between tiles form a random spanning tree of the tiles, so paths between
+     * distant cells tend to cross tiles through their few openings.
+     */
+    class TiledMazeGenerator final : public MazeGenerator {
+    public:
+        /**
+         * A function creating the generator for a tile, called concurrently from multiple threads.
+         * It is passed the column and row of the tile and the dimensions of the tile, which are those of the tiling,
+         * except for the tiles along the east and south boundaries of the maze, which may be smaller.
+         * The generator must generate mazes with the dimensions of the tile.
+         */
+        using TileGeneratorFactory =
+            std::function<std::unique_ptr<MazeGenerator>(int tileColumn, int tileRow, const types::Dimensions2D&)>;
+
+        /**
+         * Create a tiled maze generator.
+         * @param d the dimensions of the maze
+         * @param tileDimensions the dimensions of the tiles, which must be positive
+         * @param factory the factory creating the generator for each tile
+         * @param numThreads the number of threads to use (0 meaning one per hardware thread)
+         * @throws std::invalid_argument if the tile dimensions are not positive, or the factory is empty
+         */
+        TiledMazeGenerator(const types::Dimensions2D &d, const types::Dimensions2D &tileDimensions,
+                           TileGeneratorFactory factory, unsigned int numThreads = 0);
+
+        TiledMazeGenerator(int w, int h, int tileWidth, int tileHeight,
+                           TileGeneratorFactory factory, unsigned int numThreads = 0);
+
+        ~TiledMazeGenerator() final = default;
+
+        /// Generate a maze, seeding the tiles from @see{math::RNG}.
+        const Maze generate() const noexcept final;
+
+        /// Generate the maze for the given seed.
+        const Maze generate(std::uint64_t seed) const noexcept;
+
+        /// A factory creating a generator of type G for every tile.
+        template<typename G>
+        static TileGeneratorFactory factoryFor() {
+            return [](int, int, const types::Dimensions2D &d) { return std::make_unique<G>(d); };
+        }
+
+    private:
+        const types::Dimensions2D tileDimensions;
+        const TileGeneratorFactory factory;
+
+        /// The number of threads to use (0 meaning one per hardware thread).
+        const unsigned int numThreads;
+    };
+}
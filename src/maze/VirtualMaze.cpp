@@ -0,0 +1,151 @@
+/**
+ * VirtualMaze.cpp
+ *
+ * By Sebastian Raaphorst, 2018.
+ */
+
+#include <cstdint>
+
+#include <types/AbstractMaze.h>
+#include <types/BitUtils.h>
+#include <types/CommonMazeAttributes.h>
+#include <types/Dimensions2D.h>
+#include <types/Direction.h>
+#include <math/CounterRNG.h>
+#include <math/MathUtils.h>
+
+#include "Maze.h"
+#include "MazeAttributes.h"
+#include "VirtualMaze.h"
+
+namespace spelunker::maze {
+    VirtualMaze::VirtualMaze(const types::Dimensions2D &d)
+        : types::AbstractMaze{d} {}
+
+    bool VirtualMaze::wall(const int x, const int y, const types::Direction d) const {
+        checkCell(x, y);
+        switch (d) {
+            case types::Direction::NORTH: return y == 0 || southWall(x, y - 1);
+            case types::Direction::EAST:  return x == getWidth() - 1 || eastWall(x, y);
+            case types::Direction::SOUTH: return y == getHeight() - 1 || southWall(x, y);
+            case types::Direction::WEST:  return x == 0 || eastWall(x - 1, y);
+        }
+        return true;
+    }
+
+    int VirtualMaze::numCellWalls(const types::Cell &c) const {
+        const auto [x, y] = c;
+        auto num = 0;
+        for (const auto d: types::directions())
+            if (wall(x, y, d))
+                ++num;
+        return num;
+    }
+
+    const types::CellCollection VirtualMaze::neighbours(const types::Cell &c) const {
+        const auto [x, y] = c;
+        types::CellCollection cc;
+        for (const auto d: types::directions())
+            if (!wall(x, y, d))
+                cc.emplace_back(types::applyDirectionToCell(c, d));
+        return cc;
+    }
+
+    const Maze VirtualMaze::window(const int x0, const int y0, const int w, const int h) const {
+        checkCell(x0, y0);
+        checkCell(x0 + w - 1, y0 + h - 1);
+
+        const types::Dimensions2D dim{w, h};
+        auto wi = createMazeLayout(dim, true);
+        for (auto y = 0; y < h; ++y)
+            for (auto x = 0; x < w; ++x) {
+                if (x + 1 < w)
+                    wi[Maze::rankPositionS(dim, x, y, types::Direction::EAST)] = eastWall(x0 + x, y0 + y);
+                if (y + 1 < h)
+                    wi[Maze::rankPositionS(dim, x, y, types::Direction::SOUTH)] = southWall(x0 + x, y0 + y);
+            }
+        return Maze{dim, wi};
+    }
+
+    VirtualBinaryTreeMaze::VirtualBinaryTreeMaze(const types::Dimensions2D &d, const std::uint64_t seed,
+                                                 const double eastProbability)
+        : VirtualMaze{d}, seed{seed}, eastProbability{eastProbability} {
+        math::MathUtils::checkProbability(eastProbability);
+    }
+
+    VirtualBinaryTreeMaze::VirtualBinaryTreeMaze(const int w, const int h, const std::uint64_t seed,
+                                                 const double eastProbability)
+        : VirtualBinaryTreeMaze{types::Dimensions2D{w, h}, seed, eastProbability} {}
+
+    bool VirtualBinaryTreeMaze::carvesEast(const int x, const int y) const noexcept {
+        // The easternmost cell can only carve south, and the southmost row can only carve east.
+        if (x == getWidth() - 1)
+            return false;
+        if (y == getHeight() - 1)
+            return true;
+        const auto word = math::CounterRNG{seed}.bernoulliWord(static_cast<std::uint64_t>(y),
+                                                               x / types::WordBits, eastProbability);
+        return types::testBit(&word, x % types::WordBits);
+    }
+
+    bool VirtualBinaryTreeMaze::eastWall(const int x, const int y) const noexcept {
+        return !carvesEast(x, y);
+    }
+
+    bool VirtualBinaryTreeMaze::southWall(const int x, const int y) const noexcept {
+        return carvesEast(x, y);
+    }
+
+    VirtualSidewinderMaze::VirtualSidewinderMaze(const types::Dimensions2D &d, const std::uint64_t seed,
+                                                 const double probabilityEast)
+        : VirtualMaze{d}, seed{seed}, probabilityEast{probabilityEast} {
+        math::MathUtils::checkProbability(probabilityEast);
+    }
+
+    VirtualSidewinderMaze::VirtualSidewinderMaze(const int w, const int h, const std::uint64_t seed,
+                                                 const double probabilityEast)
+        : VirtualSidewinderMaze{types::Dimensions2D{w, h}, seed, probabilityEast} {}
+
+    std::uint64_t VirtualSidewinderMaze::runEnds(const int y, const int word) const noexcept {
+        // The last run always ends at the easternmost cell, and we ignore the bits past it.
+        auto ends = math::CounterRNG{seed}.bernoulliWord(static_cast<std::uint64_t>(y), word, 1 - probabilityEast);
+        const auto lastCell = getWidth() - 1;
+        if (word == lastCell / types::WordBits) {
+            const auto bit = static_cast<unsigned int>(lastCell % types::WordBits);
+            ends |= std::uint64_t{1} << bit;
+            if (bit + 1 < types::WordBits)
+                ends &= (std::uint64_t{1} << (bit + 1)) - 1;
+        }
+        return ends;
+    }
+
+    bool VirtualSidewinderMaze::eastWall(const int x, const int y) const noexcept {
+        // The southmost row is a single run.
+        if (y == getHeight() - 1)
+            return false;
+        const auto ends = runEnds(y, x / types::WordBits);
+        return types::testBit(&ends, x % types::WordBits);
+    }
+
+    bool VirtualSidewinderMaze::southWall(const int x, const int y) const noexcept {
+        // Find the run containing x: it starts after the last run end before x, and ends at the first one from x.
+        auto word = x / types::WordBits;
+        const auto bit = static_cast<unsigned int>(x % types::WordBits);
+        auto before = runEnds(y, word) & ((std::uint64_t{1} << bit) - 1);
+        while (!before && word > 0)
+            before = runEnds(y, --word);
+        const auto runStart = before ? word * types::WordBits + types::highestSetBit(before) + 1 : 0;
+
+        word = x / types::WordBits;
+        auto from = runEnds(y, word) & ~((std::uint64_t{1} << bit) - 1);
+        while (!from)
+            from = runEnds(y, ++word);
+        const auto runEnd = word * types::WordBits + types::countTrailingZeros(from);
+
+        // The counters for the cells carving south follow those used by bernoulliWord for the run ends.
+        const auto runCounters = 32 * types::numWords(static_cast<std::uint64_t>(getWidth()));
+        const auto carved = runStart + math::CounterRNG{seed}.range(static_cast<std::uint64_t>(y),
+                                                                    runCounters + runEnd, runEnd - runStart + 1);
+        return x != carved;
+    }
+}
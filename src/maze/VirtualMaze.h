@@ -0,0 +1,102 @@
+/**
+ * VirtualMaze.h
+ *
+ * By Sebastian Raaphorst, 2018.
+ *
+ * Mazes whose walls are computed on demand instead of being stored.
+ */
+
+#pragma once
+
+#include <cstdint>
+
+#include <types/AbstractMaze.h>
+#include <types/CommonMazeAttributes.h>
+#include <types/Dimensions2D.h>
+#include <types/Direction.h>
+
+namespace spelunker::maze {
+    class Maze;
+
+    /**
+     * A maze whose walls are computed on demand, for algorithms in which the walls of a cell can be determined from a
+     * counter-based hash without generating the rest of the maze. Such a maze takes no memory beyond its parameters,
+     * so it can have any dimensions, and its cells can be queried, e.g. by solvers through @see{types::AbstractMaze},
+     * or materialized a window at a time.
+     */
+    class VirtualMaze : public types::AbstractMaze {
+    public:
+        ~VirtualMaze() override = default;
+
+        /// Determine if there is a wall in the given direction from a cell. The boundary always has walls.
+        bool wall(int x, int y, types::Direction d) const;
+
+        int numCellWalls(const types::Cell &c) const override;
+
+        const types::CellCollection neighbours(const types::Cell &c) const override;
+
+        /**
+         * Materialize the cells [x0, x0 + w) x [y0, y0 + h) as a maze, whose boundary is closed.
+         * @throws OutOfBoundsException if the window does not lie within the maze
+         */
+        const Maze window(int x0, int y0, int w, int h) const;
+
+    protected:
+        explicit VirtualMaze(const types::Dimensions2D &d);
+
+        /// Determine if there is a wall to the east of a cell, for x in [0, width - 1).
+        virtual bool eastWall(int x, int y) const noexcept = 0;
+
+        /// Determine if there is a wall to the south of a cell, for y in [0, height - 1).
+        virtual bool southWall(int x, int y) const noexcept = 0;
+    };
+
+    /**
+     * The maze generated by @see{ParallelBinaryTreeMazeGenerator} for a seed, whose cells are each determined by a
+     * single word drawn from a @see{math::CounterRNG}.
+     */
+    class VirtualBinaryTreeMaze final : public VirtualMaze {
+    public:
+        VirtualBinaryTreeMaze(const types::Dimensions2D &d, std::uint64_t seed, double eastProbability = 0.5);
+        VirtualBinaryTreeMaze(int w, int h, std::uint64_t seed, double eastProbability = 0.5);
+        ~VirtualBinaryTreeMaze() final = default;
+
+    protected:
+        bool eastWall(int x, int y) const noexcept final;
+        bool southWall(int x, int y) const noexcept final;
+
+    private:
+        /// Determine if a cell carves east, as opposed to south.
+        bool carvesEast(int x, int y) const noexcept;
+
+        const std::uint64_t seed;
+        const double eastProbability;
+    };
+
+    /**
+     * The maze generated by @see{ParallelSidewinderMazeGenerator} for a seed. The walls of a cell are determined by
+     * its row alone, and then only by the run of cells containing it, which is found by scanning words of run ends.
+     *
+     * Querying the south wall of a cell thus takes time O(1 + r / 64) for a run of r cells. Runs have expected length
+     * 1 / (1 - probabilityEast), so this is O(1) expected for a fixed probabilityEast < 1, but it grows as the
+     * probability approaches 1: with probabilityEast = 1, every row is a single run, and each query scans the whole
+     * row, i.e. O(width / 64) words.
+     */
+    class VirtualSidewinderMaze final : public VirtualMaze {
+    public:
+        VirtualSidewinderMaze(const types::Dimensions2D &d, std::uint64_t seed, double probabilityEast = 0.5);
+        VirtualSidewinderMaze(int w, int h, std::uint64_t seed, double probabilityEast = 0.5);
+        ~VirtualSidewinderMaze() final = default;
+
+    protected:
+        bool eastWall(int x, int y) const noexcept final;
+        bool southWall(int x, int y) const noexcept final;
+
+    private:
+        /// The word of run ends with the given index for a row: a set bit marks the last cell of a run.
+        std::uint64_t runEnds(int y, int word) const noexcept;
+
+        const std::uint64_t seed;
+        const double probabilityEast;
+    };
+}
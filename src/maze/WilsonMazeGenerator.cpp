@@ -4,7 +4,11 @@
  * By Sebastian Raaphorst, 2018.
  */
 
-#include <map>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <tuple>
+#include <vector>
 
 #include <types/CommonMazeAttributes.h>
 #include <types/Dimensions2D.h>
@@ -23,95 +27,131 @@ namespace spelunker::maze {
     WilsonMazeGenerator::WilsonMazeGenerator(int w, int h)
         : WilsonMazeGenerator{types::Dimensions2D{w, h}} {}
 
-    const Maze WilsonMazeGenerator::generate() const noexcept {
-        const auto [width, height] = getDimensions().values();
-
-        // We start with all walls, and then remove them iteratively.
-        auto wi = createMazeLayout(getDimensions(), true);
-
-        // We need a cell lookup to check which cells are part of the maze.
-        auto ci = types::initializeCellIndicator(getDimensions(), false);
+    class WilsonMazeGenerator::Stepper final : public MazeStepper {
+    public:
+        explicit Stepper(const WilsonMazeGenerator &g)
+            : MazeStepper{g.getDimensions()},
+              gen{g},
+              wi(createMazeLayout(g.getDimensions(), true)),
+              ci(types::initializeCellIndicator(g.getDimensions(), false)),
+              exits(g.getWidth() * g.getHeight(), types::Direction::NORTH) {
+            const auto [width, height] = g.getDimensions().values();
+
+            // Pick a starting cell at random and add it to the maze.
+            const int startX = math::RNG::randomRange(width);
+            const int startY = math::RNG::randomRange(height);
+            ci[startX][startY] = true;
+            numUnvisited = width * height - 1;
+
+            // Create a list of all other cells, to be shuffled as we go and used as the starting cells of random walks.
+            for (int x = 0; x < width; ++x)
+                for (int y = 0; y < height; ++y) {
+                    if (x == startX && y == startY)
+                        continue;
+                    cellRks.emplace_back(g.rankCell(x, y));
+                }
+        }
 
-        // Pick a starting cell at random and add it to the maze.
-        const int startX = math::RNG::randomRange(width);
-        const int startY = math::RNG::randomRange(height);
-        ci[startX][startY] = true;
+        bool isDone() const noexcept final {
+            return numUnvisited == 0;
+        }
 
-        // Create a list of all cells and shuffle them to use as the
-        // starting positions for random walks.
-        std::vector<int> cellRks;
-        for (int x = 0; x < width; ++x)
-            for (int y = 0; y < height; ++y) {
-                if (x == startX && y == startY)
-                    continue;
-                cellRks.emplace_back(rankCell(x, y));
-            }
-        math::RNG::shuffle(cellRks);
-
-        // Try to start a new random walk at cellRk.
-        for (auto cellRk : cellRks) {
-            // If we have already visited this cell, skip it.
-            const auto startCell = unrankCell(cellRk);
-            auto x = startCell.first;
-            auto y = startCell.second;
-            if (ci[x][y])
-                continue;
-
-            // Generate a random walk. We do this by continuously choosing a
-            // neighbour and storing the position we entered this neighbour.
-            // prevcell and x and y should always represent the previous cell.
-            std::map<int, types::Direction> walk;
-            for (;;) {
-                // Find the neighbours and pick one at random.
-                auto nbrs = allNeighbours(types::cell(x, y));
-                auto nbr = math::RNG::randomElement(nbrs);
-
-                // Now update the map to say we reached nbr by the given
-                // position from prevCell.
-                const auto [nextCell, dir] = nbr;
-
-                // We flip the direction so we are coming into nextCell instead of leaving it.
-                walk[rankCell(x, y)] = flip(dir);
-
-                // Advance in our walk.
-                x = nextCell.first;
-                y = nextCell.second;
-
-                // If we have reached a visited cell, terminate our walk.
-                if (ci[x][y])
-                    break;
-            }
+        const Maze current() const final {
+            return Maze(getDimensions(), wi);
+        }
 
-            // Now start at the starting cell, and continue following the walk in the
-            // accumulated directions until we reach a cell in the maze.
-            // Note this will likely not be all the cells in the walk, due to the
-            // direction update. This is to prevent loops.
-            x = startCell.first;
-            y = startCell.second;
-            for (; !ci[x][y];) {
-                // Mark c as visited, remove the wall, and find the next cell.
-                ci[x][y] = true;
-                auto rk = rankCell(x, y);
-                const auto dir = walk[rk];
-                wi[rankPos(types::pos(x, y, dir))] = false;
-
-                switch (dir) {
-                    case types::Direction::NORTH:
-                        y -= 1;
-                        break;
-                    case types::Direction::EAST:
-                        x += 1;
+    protected:
+        std::uint64_t run(const std::uint64_t maxSteps) final {
+            std::uint64_t steps = 0;
+            for (; steps < maxSteps && numUnvisited > 0; ++steps) {
+                switch (phase) {
+                    case Phase::STARTING: {
+                        // Try to start a new random walk at a random cell not yet tried.
+                        if (nextStart + 1 < cellRks.size())
+                            std::swap(cellRks[nextStart],
+                                      cellRks[math::RNG::randomRange(static_cast<int>(nextStart),
+                                                                     static_cast<int>(cellRks.size()))]);
+                        startCell = gen.unrankCell(cellRks[nextStart++]);
+                        std::tie(x, y) = startCell;
+
+                        // If we have already visited this cell, skip it.
+                        if (!ci[x][y])
+                            phase = Phase::WALKING;
                         break;
-                    case types::Direction::SOUTH:
-                        y += 1;
+                    }
+
+                    case Phase::WALKING: {
+                        // Extend the random walk, storing the direction in which we leave each cell.
+                        types::Direction dirs[4];
+                        const auto numDirs = gen.neighbourDirections(x, y, dirs);
+                        const auto dir = dirs[math::RNG::randomRange(numDirs)];
+                        exits[gen.rankCell(x, y)] = dir;
+                        std::tie(x, y) = types::applyDirectionToCell(types::cell(x, y), dir);
+
+                        // If we have reached a visited cell, terminate our walk, and go back to its start.
+                        if (ci[x][y]) {
+                            std::tie(x, y) = startCell;
+                            phase = Phase::CARVING;
+                        }
                         break;
-                    case types::Direction::WEST:
-                        x -= 1;
+                    }
+
+                    case Phase::CARVING: {
+                        // Follow the walk in the accumulated directions until we reach a cell in the maze.
+                        // Note this will likely not be all the cells in the walk, due to the direction update.
+                        // This is to prevent loops. Mark each cell as visited, and remove the wall to the next one.
+                        ci[x][y] = true;
+                        --numUnvisited;
+                        const auto dir = exits[gen.rankCell(x, y)];
+                        wi[gen.rankPos(types::pos(x, y, dir))] = false;
+                        std::tie(x, y) = types::applyDirectionToCell(types::cell(x, y), dir);
+                        if (ci[x][y])
+                            phase = Phase::STARTING;
                         break;
+                    }
                 }
             }
+            return steps;
         }
 
-        return Maze(width, height, wi);
+    private:
+        enum class Phase {
+            STARTING,
+            WALKING,
+            CARVING,
+        };
+
+        const WilsonMazeGenerator gen;
+
+        // We start with all walls, and then remove them iteratively.
+        WallIncidence wi;
+
+        // We need a cell lookup to check which cells are part of the maze.
+        types::CellIndicator ci;
+        int numUnvisited;
+
+        // The direction in which the current random walk last left each cell. Since a later exit overwrites an
+        // earlier one, following these directions from the start of a walk gives the walk with its loops erased.
+        std::vector<types::Direction> exits;
+
+        // The cells at which to start random walks, shuffled up to nextStart, which is the next to try.
+        std::vector<int> cellRks;
+        std::size_t nextStart = 0;
+
+        // The phase of the current walk, its starting cell, and the current cell.
+        Phase phase = Phase::STARTING;
+        types::Cell startCell;
+        int x = 0;
+        int y = 0;
+    };
+
+    const Maze WilsonMazeGenerator::generate() const noexcept {
+        Stepper stepper{*this};
+        stepper.finish();
+        return stepper.current();
+    }
+
+    std::unique_ptr<MazeStepper> WilsonMazeGenerator::stepper() const {
+        return std::make_unique<Stepper>(*this);
     }
-}
\ No newline at end of file
+}
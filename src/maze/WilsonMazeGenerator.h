@@ -10,6 +10,8 @@
 
 #pragma once
 
+#include <memory>
+
 #include <types/Dimensions2D.h>
 
 #include "MazeGenerator.h"
@@ -39,5 +41,15 @@ namespace spelunker::maze {
         ~WilsonMazeGenerator() final = default;
 
         const Maze generate() const noexcept final;
+
+        /**
+         * Begin a generation that can be advanced a bounded number of steps at a time, which produces the same
+         * mazes as @see{generate}. A step is a move of a random walk, or the carving of a passage along its
+         * loop-erased path.
+         */
+        std::unique_ptr<MazeStepper> stepper() const;
+
+    private:
+        class Stepper;
     };
 };
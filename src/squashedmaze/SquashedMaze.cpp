@@ -15,6 +15,7 @@
 #include <maze/Maze.h>
 #include <types/CommonMazeAttributes.h>
 #include <types/AbstractMaze.h>
+#include <types/Parallel.h>
 #include <typeclasses/Show.h>
 #include "RoomFinder.h"
 #include "SquashedMazeAttributes.h"
@@ -27,7 +28,10 @@ using namespace std;
 
 namespace spelunker::squashedmaze {
 
-    SquashedMaze::SquashedMaze(const spelunker::types::AbstractMaze &m) {
+    SquashedMaze::SquashedMaze(const spelunker::types::AbstractMaze &m)
+        : SquashedMaze{m, 1} {}
+
+    SquashedMaze::SquashedMaze(const spelunker::types::AbstractMaze &m, const unsigned int numThreads) {
         // A convenience method to extract the weight of a weighted edge.
         const auto wt = [](const auto &e) {
             return *(reinterpret_cast<int *>(e.m_eproperty));
@@ -100,6 +104,10 @@ namespace spelunker::squashedmaze {
         // creating an edge beginning at this vertex in the squashed graph.
         const auto collectionToVertices = [&](const types::CellCollection &cc) {
             for (const auto &c: cc) {
+                // Room entrances can also be dead ends or junctions: they already have a vertex and an edge start.
+                if (vertexCell.find(c) != vertexCell.end())
+                    continue;
+
                 // Create a vertex for the cell.
                 const auto v = boost::add_vertex(graph);
                 vertexCell[c] = v;
@@ -164,6 +172,14 @@ namespace spelunker::squashedmaze {
         };
 
 
+        // If we are to use multiple threads, drain the queue and trace the corridors from each start concurrently.
+        if (numThreads != 1) {
+            types::CellCollection starts;
+            for (; !edgeQueue.empty(); edgeQueue.pop())
+                starts.emplace_back(edgeQueue.front().cells.front());
+            traceCorridors(m, starts, roomCells, ci, numThreads);
+        }
+
         while (!edgeQueue.empty()) {
             const auto edgeStart = edgeQueue.front();
             edgeQueue.pop();
@@ -375,4 +391,114 @@ namespace spelunker::squashedmaze {
 
         return entrances;
     }
-}
\ No newline at end of file
+
+    void SquashedMaze::traceCorridors(const types::AbstractMaze &m,
+                                      const types::CellCollection &starts,
+                                      const types::CellCollection &roomCells,
+                                      types::CellIndicator &ci,
+                                      const unsigned int numThreads) {
+        const auto width = m.getWidth();
+        const auto height = m.getHeight();
+        const auto rank = [width](const types::Cell &c) { return c.second * width + c.first; };
+
+        // Flatten the vertex and room lookups so that the threads only ever read from contiguous arrays.
+        constexpr int noVertex = -1;
+        std::vector<int> vertexAt(width * height, noVertex);
+        for (const auto &[c, v]: vertexCell)
+            vertexAt[rank(c)] = static_cast<int>(v);
+        std::vector<char> isRoomCell(width * height, false);
+        for (const auto &c: roomCells)
+            isRoomCell[rank(c)] = true;
+
+        // A corridor from vertex u to vertex v, covering the cells from u up to but not including v.
+        // We record corridors that loop back to u or end without reaching a vertex, as their cells are still covered.
+        struct Corridor {
+            int u;
+            int v;
+            types::CellCollection cells;
+        };
+        std::vector<std::vector<Corridor>> buffers(numThreads == 0 ? types::defaultNumThreads() : numThreads);
+
+        types::parallelFor(0, static_cast<int>(starts.size()), numThreads, [&](int block, int begin, int end) {
+            auto &buffer = buffers[block];
+            for (auto i = begin; i < end; ++i) {
+                const auto &start = starts[i];
+                const auto u = vertexAt[rank(start)];
+
+                for (const auto &first: m.neighbours(start)) {
+                    if (isRoomCell[rank(first)]) continue;
+
+                    // Follow the corridor until we hit a vertex. Every cell along the way has exactly two neighbours,
+                    // so there is only ever one way to continue.
+                    types::CellCollection cells{start};
+                    auto prev = start;
+                    auto cur = first;
+                    for (;;) {
+                        const auto v = vertexAt[rank(cur)];
+                        if (v != noVertex) {
+                            buffer.emplace_back(Corridor{u, v, cells});
+                            break;
+                        }
+                        cells.emplace_back(cur);
+
+                        auto nbrs = m.neighbours(cur);
+                        nbrs.erase(std::remove_if(nbrs.begin(), nbrs.end(), [&](const types::Cell &c) {
+                            return c == prev || isRoomCell[rank(c)];
+                        }), nbrs.end());
+                        if (nbrs.size() != 1) {
+                            buffer.emplace_back(Corridor{u, noVertex, cells});
+                            break;
+                        }
+
+                        prev = cur;
+                        cur = nbrs.front();
+                    }
+                }
+            }
+        });
+
+        // Every corridor is traced once from each end. Keep the lowest weight corridor for each pair of vertices,
+        // preferring the one traced from the lower vertex so that the result does not depend on the thread count.
+        std::map<std::pair<int, int>, const Corridor*> best;
+        for (const auto &buffer: buffers) {
+            for (const auto &corridor: buffer) {
+                for (const auto &[cx, cy]: corridor.cells)
+                    ci[cx][cy] = true;
+
+                // Corridors that loop back to their own vertex are never shortest paths, and corridors that do not
+                // end at a vertex do not contribute an edge.
+                if (corridor.v == corridor.u || corridor.v == noVertex)
+                    continue;
+
+                const auto key = std::minmax(corridor.u, corridor.v);
+                const auto iter = best.find(key);
+                if (iter == best.end()) {
+                    best.emplace(key, &corridor);
+                    continue;
+                }
+
+                const auto &current = *iter->second;
+                if (corridor.cells.size() < current.cells.size()
+                    || (corridor.cells.size() == current.cells.size() && corridor.u < corridor.v && current.u > current.v))
+                    iter->second = &corridor;
+            }
+        }
+
+        // Merge into the graph. Rooms may already have contributed an edge between two entrances: as with the
+        // sequential construction, we only replace it if the corridor is shorter.
+        for (const auto &[key, corridor]: best) {
+            const auto weight = static_cast<int>(corridor->cells.size());
+            auto [e0, exists] = boost::edge(corridor->u, corridor->v, graph);
+            if (exists && weight < boost::get(boost::edge_weight, graph, e0)) {
+                edges.erase(e0);
+                boost::remove_edge(corridor->u, corridor->v, graph);
+                exists = false;
+            }
+
+            if (!exists) {
+                const auto [e, success] = boost::add_edge(corridor->u, corridor->v, weight, graph);
+                edges[e] = corridor->cells;
+            }
+        }
+    }
+}
@@ -50,6 +50,18 @@ namespace spelunker::squashedmaze {
          */
         explicit SquashedMaze(const types::AbstractMaze &m);
 
+        /**
+         * Given an AbstractMaze, create the representative SquashedMaze, tracing the corridors with multiple threads.
+         *
+         * Instead of growing every corridor from a single shared queue, each vertex traces its corridors concurrently
+         * into a per-thread buffer. The buffers are then merged on the calling thread, keeping the lowest weight edge
+         * between any pair of vertices, so the resulting graph has the same vertices and edge weights as the
+         * sequential construction. A numThreads of 1 uses the sequential construction.
+         * @param m the original maze
+         * @param numThreads the number of threads to use (0 meaning one per hardware thread)
+         */
+        SquashedMaze(const types::AbstractMaze &m, unsigned int numThreads);
+
         ~SquashedMaze() = default;
 
         /// Return the mapping from graph edge to the cells in the original maze.
@@ -80,6 +92,21 @@ namespace spelunker::squashedmaze {
          */
         types::CellCollection processRoom(const types::AbstractMaze &m, const types::CellCollection &cc);
 
+        /**
+         * Trace all the corridors leaving the specified vertex cells concurrently, and add the resulting edges.
+         * A corridor is a sequence of cells with exactly two neighbours: it runs from one vertex cell to another.
+         * @param m the original maze
+         * @param starts the vertex cells from which to trace corridors
+         * @param roomCells the room cells that are not entrances, which corridors cannot enter
+         * @param ci the cell indicator, where the cells covered by the corridors will be marked as visited
+         * @param numThreads the number of threads to use
+         */
+        void traceCorridors(const types::AbstractMaze &m,
+                            const types::CellCollection &starts,
+                            const types::CellCollection &roomCells,
+                            types::CellIndicator &ci,
+                            unsigned int numThreads);
+
         /// Each edge covers multiple cells. We map between cells and edges.
         EdgeCellMap edges;
 
@@ -9,9 +9,14 @@
 #include <memory>
 #include <vector>
 
+#include <types/CommonMazeAttributes.h>
 #include <types/Dimensions2D.h>
+#include <types/Direction.h>
+#include <maze/Maze.h>
+#include <maze/MazeAttributes.h>
 #include <maze/MazeGenerator.h>
 #include <maze/AldousBroderMazeGenerator.h>
+#include <maze/AldousBroderWilsonMazeGenerator.h>
 #include <maze/BFSMazeGenerator.h>
 #include <maze/BinaryTreeMazeGenerator.h>
 #include <maze/DFSMazeGenerator.h>
@@ -19,12 +24,38 @@
 #include <maze/GrowingTreeMazeGenerator.h>
 #include <maze/HuntAndKillMazeGenerator.h>
 #include <maze/KruskalMazeGenerator.h>
+#include <maze/OriginShiftMazeGenerator.h>
+#include <maze/ParallelBFSMazeGenerator.h>
+#include <maze/ParallelBinaryTreeMazeGenerator.h>
+#include <maze/ParallelKruskalMazeGenerator.h>
+#include <maze/ParallelRecursiveDivisionMazeGenerator.h>
+#include <maze/ParallelSidewinderMazeGenerator.h>
 #include <maze/PrimMazeGenerator.h>
 #include <maze/Prim2MazeGenerator.h>
+#include <maze/ProppWilsonMazeGenerator.h>
 #include <maze/RecursiveDivisionMazeGenerator.h>
 #include <maze/SidewinderMazeGenerator.h>
+#include <maze/TiledMazeGenerator.h>
 #include <maze/WilsonMazeGenerator.h>
+
 namespace spelunker::maze {
+    /// A generator of a fixed maze, for tests needing known walls: a passage along the top row, with a passage down
+    /// from every cell of it.
+    class CombMazeGenerator final : public MazeGenerator {
+    public:
+        explicit CombMazeGenerator(const types::Dimensions2D &d) : MazeGenerator{d} {}
+
+        const Maze generate() const noexcept final {
+            auto wi = createMazeLayout(getDimensions(), true);
+            for (auto x = 0; x + 1 < getWidth(); ++x)
+                wi[rankPos(types::pos(x, 0, types::Direction::EAST))] = false;
+            for (auto y = 0; y + 1 < getHeight(); ++y)
+                for (auto x = 0; x < getWidth(); ++x)
+                    wi[rankPos(types::pos(x, y, types::Direction::SOUTH))] = false;
+            return Maze{getDimensions(), wi};
+        }
+    };
+
     /**
      * This is just a quick and dirty class of all MazeGenerators, used
      * strictly for testing purposes.
@@ -40,6 +71,7 @@ namespace spelunker::maze {
 
             // I want to use std::make_unique here, but no matter what I do, Travis fails.
             gens.emplace_back(std::unique_ptr<maze::AldousBroderMazeGenerator>(new maze::AldousBroderMazeGenerator{d}));
+            gens.emplace_back(std::unique_ptr<maze::AldousBroderWilsonMazeGenerator>(new maze::AldousBroderWilsonMazeGenerator{d}));
             gens.emplace_back(std::unique_ptr<maze::BFSMazeGenerator>(new maze::BFSMazeGenerator{d}));
             gens.emplace_back(std::unique_ptr<maze::BinaryTreeMazeGenerator>(new maze::BinaryTreeMazeGenerator{d}));
             gens.emplace_back(std::unique_ptr<maze::DFSMazeGenerator>(new maze::DFSMazeGenerator{d}));
@@ -47,10 +79,18 @@ namespace spelunker::maze {
             gens.emplace_back(std::unique_ptr<maze::GrowingTreeMazeGenerator>(new maze::GrowingTreeMazeGenerator{d, maze::GrowingTreeMazeGenerator::CellSelectionStrategy::RANDOM}));
             gens.emplace_back(std::unique_ptr<maze::HuntAndKillMazeGenerator>(new maze::HuntAndKillMazeGenerator{d}));
             gens.emplace_back(std::unique_ptr<maze::KruskalMazeGenerator>(new maze::KruskalMazeGenerator{d}));
+            gens.emplace_back(std::unique_ptr<maze::OriginShiftMazeGenerator>(new maze::OriginShiftMazeGenerator{d}));
+            gens.emplace_back(std::unique_ptr<maze::ParallelBFSMazeGenerator>(new maze::ParallelBFSMazeGenerator{d}));
+            gens.emplace_back(std::unique_ptr<maze::ParallelBinaryTreeMazeGenerator>(new maze::ParallelBinaryTreeMazeGenerator{d}));
+            gens.emplace_back(std::unique_ptr<maze::ParallelKruskalMazeGenerator>(new maze::ParallelKruskalMazeGenerator{d}));
+            gens.emplace_back(std::unique_ptr<maze::ParallelRecursiveDivisionMazeGenerator>(new maze::ParallelRecursiveDivisionMazeGenerator{d}));
+            gens.emplace_back(std::unique_ptr<maze::ParallelSidewinderMazeGenerator>(new maze::ParallelSidewinderMazeGenerator{d}));
             gens.emplace_back(std::unique_ptr<maze::PrimMazeGenerator>(new maze::PrimMazeGenerator{d}));
             gens.emplace_back(std::unique_ptr<maze::Prim2MazeGenerator>(new maze::Prim2MazeGenerator{d}));
+            gens.emplace_back(std::unique_ptr<maze::ProppWilsonMazeGenerator>(new maze::ProppWilsonMazeGenerator{d}));
             gens.emplace_back(std::unique_ptr<maze::RecursiveDivisionMazeGenerator>(new maze::RecursiveDivisionMazeGenerator{d}));
             gens.emplace_back(std::unique_ptr<maze::SidewinderMazeGenerator>(new maze::SidewinderMazeGenerator{d}));
+            gens.emplace_back(std::unique_ptr<maze::TiledMazeGenerator>(new maze::TiledMazeGenerator{d, types::Dimensions2D{16, 12}, maze::TiledMazeGenerator::factoryFor<maze::DFSMazeGenerator>()}));
             gens.emplace_back(std::unique_ptr<maze::WilsonMazeGenerator>(new maze::WilsonMazeGenerator{d}));
         }
 
@@ -0,0 +1,43 @@
+/**
+ * ParallelMazeGeneratorChecks.h
+ *
+ * By Sebastian Raaphorst, 2018.
+ */
+
+#pragma once
+
+#include <catch.hpp>
+
+#include <cstdint>
+#include <utility>
+
+#include <maze/Maze.h>
+
+namespace spelunker::maze {
+    /**
+     * The checks common to all the generators that divide their work amongst threads, used strictly for testing
+     * purposes: the maze for a seed is perfect and the same for any number of threads, and mazes of degenerate
+     * dimensions are generated correctly.
+     *
+     * @tparam F a function creating a generator from a width, a height, and a number of threads
+     * @param make the function creating the generators
+     * @param width the width of the mazes to compare
+     * @param height the height of the mazes to compare
+     */
+    template<typename F>
+    void checkParallelMazeGenerator(F make, const int width = 80, const int height = 60) {
+        constexpr std::uint64_t seed = 0x5eed;
+
+        const auto m = make(width, height, 1u).generate(seed);
+        REQUIRE(m.findConnectedComponents().size() == 1);
+        REQUIRE(m.numCarvedWalls() == width * height - 1);
+        for (const auto numThreads: {2u, 3u, 8u})
+            REQUIRE(make(width, height, numThreads).generate(seed) == m);
+        REQUIRE(make(width, height, 1u).generate(seed + 1) != m);
+
+        // A single cell, and a single column or row, of which there is only one maze.
+        for (const auto &[w, h]: {std::make_pair(1, 1), std::make_pair(1, 30), std::make_pair(70, 1)})
+            for (const auto numThreads: {1u, 4u})
+                REQUIRE(make(w, h, numThreads).generate(seed).numCarvedWalls() == w * h - 1);
+    }
+}
@@ -0,0 +1,61 @@
+/**
+ * TestAldousBroderWilsonMazeGenerator.cpp
+ *
+ * By Sebastian Raaphorst, 2018.
+ *
+ * Tests that the AldousBroderWilsonMazeGenerator produces uniformly distributed perfect mazes.
+ */
+
+#include <catch.hpp>
+
+#include <map>
+#include <vector>
+
+#include <types/Direction.h>
+#include <maze/AldousBroderWilsonMazeGenerator.h>
+#include <maze/Maze.h>
+
+using namespace spelunker;
+
+TEST_CASE("AldousBroderWilsonMazeGenerator generates perfect mazes", "[maze][aldousbroderwilson]") {
+    constexpr auto width = 63;
+    constexpr auto height = 41;
+
+    for (const auto switchOver: {0.0, 0.25, 0.5, 0.9, 1.0}) {
+        const maze::AldousBroderWilsonMazeGenerator gen{width, height, switchOver};
+        const auto m = gen.generate();
+        REQUIRE(m.findConnectedComponents().size() == 1);
+        REQUIRE(m.numCarvedWalls() == width * height - 1);
+    }
+
+    REQUIRE(maze::AldousBroderWilsonMazeGenerator{1, 1}.generate().numCarvedWalls() == 0);
+}
+
+TEST_CASE("AldousBroderWilsonMazeGenerator samples spanning trees uniformly", "[maze][aldousbroderwilson]") {
+    // A 3x2 grid has exactly 15 spanning trees.
+    constexpr auto numTrees = 15;
+    constexpr auto samples = 15000;
+    const maze::AldousBroderWilsonMazeGenerator gen{3, 2};
+
+    std::map<std::vector<bool>, int> counts;
+    for (auto i = 0; i < samples; ++i) {
+        const auto m = gen.generate();
+        std::vector<bool> walls;
+        for (auto y = 0; y < 2; ++y)
+            for (auto x = 0; x < 3; ++x)
+                for (const auto d: {types::Direction::EAST, types::Direction::SOUTH})
+                    walls.emplace_back(m.wall(x, y, d));
+        ++counts[walls];
+    }
+
+    REQUIRE(counts.size() == numTrees);
+    for (const auto &[walls, count]: counts) {
+        REQUIRE(count > 800);
+        REQUIRE(count < 1200);
+    }
+}
+
+TEST_CASE("AldousBroderWilsonMazeGenerator rejects illegal switch-over fractions", "[maze][aldousbroderwilson]") {
+    REQUIRE_THROWS(maze::AldousBroderWilsonMazeGenerator{10, 10, -0.1});
+    REQUIRE_THROWS(maze::AldousBroderWilsonMazeGenerator{10, 10, 1.1});
+}
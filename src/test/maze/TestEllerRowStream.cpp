@@ -0,0 +1,95 @@
+/**
+ * TestEllerRowStream.cpp
+ *
+ * By Sebastian Raaphorst, 2018.
+ *
+ * Tests that mazes generated row by row with Eller's algorithm are perfect.
+ */
+
+#include <catch.hpp>
+
+#include <sstream>
+#include <string>
+
+#include <types/CommonMazeAttributes.h>
+#include <types/Direction.h>
+#include <maze/EllerMazeGenerator.h>
+#include <maze/Maze.h>
+#include <maze/MazeAttributes.h>
+
+using namespace spelunker;
+
+namespace {
+    /// Assemble the rows produced by a generator into a maze.
+    maze::Maze assemble(const maze::EllerMazeGenerator &gen, const int width, const int height) {
+        const types::Dimensions2D dim{width, height};
+        auto wi = maze::createMazeLayout(dim, true);
+        auto nextRow = 0;
+        gen.generateRows(height, [&](const maze::EllerRow &row) {
+            REQUIRE(row.y == nextRow++);
+            REQUIRE(static_cast<int>(row.eastWalls.size()) == width - 1);
+            REQUIRE(static_cast<int>(row.southWalls.size()) == width);
+            for (auto x = 0; x < width - 1; ++x)
+                wi[maze::Maze::rankPositionS(dim, x, row.y, types::Direction::EAST)] = row.eastWalls[x];
+            for (auto x = 0; x < width; ++x)
+                if (row.y < height - 1)
+                    wi[maze::Maze::rankPositionS(dim, x, row.y, types::Direction::SOUTH)] = row.southWalls[x];
+                else
+                    REQUIRE(row.southWalls[x]);
+        });
+        REQUIRE(nextRow == height);
+        return maze::Maze{dim, wi};
+    }
+}
+
+TEST_CASE("Mazes streamed row by row with Eller's algorithm are perfect", "[maze][eller]") {
+    for (const auto p: {0.1, 0.5, 0.9})
+        for (const auto d: {0.1, 0.5, 1.0}) {
+            constexpr auto width = 30;
+            constexpr auto height = 200;
+            const maze::EllerMazeGenerator gen{width, 1, p, d};
+            const auto m = assemble(gen, width, height);
+            REQUIRE(m.findConnectedComponents().size() == 1);
+            REQUIRE(m.numCarvedWalls() == width * height - 1);
+        }
+}
+
+TEST_CASE("Eller's algorithm streams rows to an output stream", "[maze][eller]") {
+    constexpr auto width = 17;
+    constexpr auto height = 25;
+    const maze::EllerMazeGenerator gen{width, height};
+
+    std::stringstream ss;
+    gen.generateRows(height, ss);
+
+    std::string line;
+    auto numRows = 0;
+    while (std::getline(ss, line)) {
+        REQUIRE(static_cast<int>(line.size()) == width);
+        for (const auto c: line)
+            REQUIRE(('0' <= c && c <= '3'));
+
+        // The eastern boundary always has a wall, and the last row has no passages south.
+        REQUIRE(((line.back() - '0') & 1) == 1);
+        if (numRows == height - 1)
+            for (const auto c: line)
+                REQUIRE(((c - '0') & 2) == 2);
+        ++numRows;
+    }
+    REQUIRE(numRows == height);
+}
+
+TEST_CASE("Eller row streams can run indefinitely", "[maze][eller]") {
+    maze::EllerRowStream stream{8, 0.5, 0.5};
+    for (auto y = 0; y < 10000; ++y) {
+        const auto row = stream.nextRow();
+        REQUIRE(row.y == y);
+
+        // Every set must continue downward, so at least one cell has a passage south.
+        auto open = false;
+        for (const auto wall: row.southWalls)
+            open = open || !wall;
+        REQUIRE(open);
+    }
+    REQUIRE(stream.getNextRowIndex() == 10000);
+}
@@ -0,0 +1,56 @@
+/**
+ * TestGrowingTreeMazeGenerator.cpp
+ *
+ * By Sebastian Raaphorst, 2018.
+ *
+ * Tests that the GrowingTreeMazeGenerator produces perfect mazes for every strategy and mix of strategies.
+ */
+
+#include <catch.hpp>
+
+#include <stdexcept>
+
+#include <types/CommonMazeAttributes.h>
+#include <maze/GrowingTreeMazeGenerator.h>
+#include <maze/Maze.h>
+
+using namespace spelunker;
+
+namespace {
+    using Strategy = maze::GrowingTreeMazeGenerator::CellSelectionStrategy;
+    using WeightedStrategies = maze::GrowingTreeMazeGenerator::WeightedStrategies;
+
+    constexpr auto width = 63;
+    constexpr auto height = 41;
+
+    void checkPerfect(const maze::GrowingTreeMazeGenerator &gen) {
+        const auto m = gen.generate();
+        REQUIRE(m.findConnectedComponents().size() == 1);
+        REQUIRE(m.numCarvedWalls() == width * height - 1);
+    }
+}
+
+TEST_CASE("GrowingTreeMazeGenerator generates perfect mazes for each strategy", "[maze][growingtree]") {
+    for (const auto s: {Strategy::OLDEST, Strategy::NEWEST, Strategy::MIDDLE, Strategy::RANDOM})
+        checkPerfect(maze::GrowingTreeMazeGenerator{width, height, s});
+
+    checkPerfect(maze::GrowingTreeMazeGenerator{width, height, [](const types::CellCollection &c) {
+        return static_cast<int>(c.size()) / 3;
+    }});
+}
+
+TEST_CASE("GrowingTreeMazeGenerator generates perfect mazes for mixed strategies", "[maze][growingtree]") {
+    checkPerfect(maze::GrowingTreeMazeGenerator{width, height, WeightedStrategies{{Strategy::NEWEST, 0.75},
+                                                                                  {Strategy::RANDOM, 0.25}}});
+    checkPerfect(maze::GrowingTreeMazeGenerator{width, height, WeightedStrategies{{Strategy::OLDEST, 1},
+                                                                                  {Strategy::MIDDLE, 1},
+                                                                                  {Strategy::NEWEST, 0}}});
+}
+
+TEST_CASE("GrowingTreeMazeGenerator rejects invalid strategy weights", "[maze][growingtree]") {
+    REQUIRE_THROWS_AS((maze::GrowingTreeMazeGenerator{width, height, WeightedStrategies{}}), std::invalid_argument);
+    REQUIRE_THROWS_AS((maze::GrowingTreeMazeGenerator{width, height, WeightedStrategies{{Strategy::NEWEST, -1}}}),
+                      std::invalid_argument);
+    REQUIRE_THROWS_AS((maze::GrowingTreeMazeGenerator{width, height, WeightedStrategies{{Strategy::NEWEST, 0}}}),
+                      std::invalid_argument);
+}
@@ -13,6 +13,8 @@
 #include <maze/DFSMazeGenerator.h>
 #include <maze/Maze.h>
 
+#include "MazeGenerators.h"
+
 using namespace spelunker;
 
 TEST_CASE("Maze should be able to serialize and deserialize", "[maze][serialization]") {
@@ -74,3 +76,12 @@ TEST_CASE("Maze neighbours should obey expected rules") {
             }
     }
 }
+
+TEST_CASE("All generators produce perfect mazes", "[maze][perfect]") {
+    const auto mg = maze::MazeGenerators{};
+    for (const auto &gen: mg.getGenerators()) {
+        const auto m = gen->generate();
+        REQUIRE(m.findConnectedComponents().size() == 1);
+        REQUIRE(m.numCarvedWalls() == maze::MazeGenerators::width * maze::MazeGenerators::height - 1);
+    }
+}
@@ -0,0 +1,95 @@
+/**
+ * TestMazeRegeneration.cpp
+ *
+ * By Sebastian Raaphorst, 2018.
+ *
+ * Tests that regenerating a region of a perfect maze keeps it perfect and leaves the rest of it alone.
+ */
+
+#include <catch.hpp>
+
+#include <tuple>
+
+#include <types/Dimensions2D.h>
+#include <types/Direction.h>
+#include <types/Exceptions.h>
+#include <maze/DFSMazeGenerator.h>
+#include <maze/KruskalMazeGenerator.h>
+#include <maze/Maze.h>
+#include <maze/MazeGenerator.h>
+#include <maze/SidewinderMazeGenerator.h>
+#include <maze/WilsonMazeGenerator.h>
+
+#include "MazeGenerators.h"
+
+using namespace spelunker;
+
+namespace {
+    bool isPerfect(const maze::Maze &m) {
+        const auto [width, height] = m.getDimensions().values();
+        return m.findConnectedComponents().size() == 1 && m.numCarvedWalls() == width * height - 1;
+    }
+
+    bool inRegion(const int x, const int y, const int x0, const int y0, const int w, const int h) {
+        return x0 <= x && x < x0 + w && y0 <= y && y < y0 + h;
+    }
+}
+
+TEST_CASE("Regenerating a region keeps a maze perfect", "[maze][regeneration]") {
+    constexpr auto width = 30;
+    constexpr auto height = 20;
+
+    // Regions in a corner, along an edge, in the interior, of a single cell, and of the whole maze.
+    for (const auto &[x0, y0, w, h]: {std::make_tuple(0, 0, 7, 5), std::make_tuple(10, 0, 9, 4),
+                                      std::make_tuple(23, 14, 7, 6), std::make_tuple(6, 5, 12, 9),
+                                      std::make_tuple(4, 4, 1, 1), std::make_tuple(0, 0, width, height)}) {
+        const auto gens = maze::MazeGenerators{types::Dimensions2D{w, h}};
+        for (const auto &gen: gens.getGenerators()) {
+            const auto original = maze::KruskalMazeGenerator{width, height}.generate();
+            auto m = original;
+            m.regenerateRegion(x0, y0, *gen);
+            REQUIRE(isPerfect(m));
+
+            // Nothing outside of the region, including its boundary, changes.
+            for (auto y = 0; y < height; ++y)
+                for (auto x = 0; x < width; ++x)
+                    for (const auto d: {types::Direction::EAST, types::Direction::SOUTH}) {
+                        const auto [nx, ny] = types::applyDirectionToCell(types::cell(x, y), d);
+                        if (inRegion(x, y, x0, y0, w, h) && inRegion(nx, ny, x0, y0, w, h))
+                            continue;
+                        REQUIRE(m.wall(x, y, d) == original.wall(x, y, d));
+                    }
+        }
+    }
+}
+
+TEST_CASE("Regenerating a connected region gives the generated maze", "[maze][regeneration]") {
+    constexpr auto w = 6;
+    constexpr auto h = 5;
+    const maze::CombMazeGenerator comb{types::Dimensions2D{w, h}};
+    const auto expected = comb.generate();
+
+    SECTION("the whole maze") {
+        auto m = maze::DFSMazeGenerator{w, h}.generate();
+        m.regenerateRegion(0, 0, comb);
+        REQUIRE(m == expected);
+    }
+
+    SECTION("a region that was connected inside the maze") {
+        // A region along the top of a comb is connected, as is any perfect maze regenerated into it,
+        // so regenerating it with a comb restores the original maze.
+        auto m = maze::CombMazeGenerator{types::Dimensions2D{20, 15}}.generate();
+        const auto original = m;
+        m.regenerateRegion(3, 0, maze::SidewinderMazeGenerator{w, h});
+        m.regenerateRegion(3, 0, comb);
+        REQUIRE(m == original);
+    }
+}
+
+TEST_CASE("Regenerating a region outside of the maze throws", "[maze][regeneration]") {
+    auto m = maze::WilsonMazeGenerator{10, 10}.generate();
+    REQUIRE_THROWS_AS(m.regenerateRegion(5, 5, maze::CombMazeGenerator{types::Dimensions2D{6, 2}}),
+                      types::OutOfBoundsCoordinates);
+    REQUIRE_THROWS_AS(m.regenerateRegion(-1, 0, maze::CombMazeGenerator{types::Dimensions2D{2, 2}}),
+                      types::OutOfBoundsCoordinates);
+}
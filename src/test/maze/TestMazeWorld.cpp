@@ -0,0 +1,138 @@
+/**
+ * TestMazeWorld.cpp
+ *
+ * By Sebastian Raaphorst, 2018.
+ *
+ * Tests that the chunks of a MazeWorld are deterministic, agree with their neighbours, and connect the world.
+ */
+
+#include <catch.hpp>
+
+#include <cstdint>
+#include <stdexcept>
+
+#include <types/Dimensions2D.h>
+#include <types/Direction.h>
+#include <maze/DFSMazeGenerator.h>
+#include <maze/Maze.h>
+#include <maze/MazeAttributes.h>
+#include <maze/MazeWorld.h>
+#include <maze/WilsonMazeGenerator.h>
+
+using namespace spelunker;
+
+namespace {
+    constexpr std::uint64_t seed = 0x30f1d;
+    const types::Dimensions2D chunkDimensions{9, 7};
+
+    /// Copy the walls of the cells [x0, x0 + width) x [y0, y0 + height) of the world into a maze.
+    maze::Maze window(maze::MazeWorld &world, const std::int64_t x0, const std::int64_t y0,
+                      const int width, const int height) {
+        const types::Dimensions2D dim{width, height};
+        auto wi = maze::createMazeLayout(dim, true);
+        for (auto y = 0; y < height; ++y)
+            for (auto x = 0; x < width; ++x) {
+                if (x + 1 < width)
+                    wi[maze::Maze::rankPositionS(dim, x, y, types::Direction::EAST)] =
+                            world.wall(x0 + x, y0 + y, types::Direction::EAST);
+                if (y + 1 < height)
+                    wi[maze::Maze::rankPositionS(dim, x, y, types::Direction::SOUTH)] =
+                            world.wall(x0 + x, y0 + y, types::Direction::SOUTH);
+            }
+        return maze::Maze{dim, wi};
+    }
+}
+
+TEST_CASE("MazeWorld chunks depend only on the seed and their coordinates", "[maze][world]") {
+    maze::MazeWorld world1{seed, chunkDimensions, maze::MazeWorld::factoryFor<maze::DFSMazeGenerator>(), 4, 0};
+    maze::MazeWorld world2{seed, chunkDimensions, maze::MazeWorld::factoryFor<maze::DFSMazeGenerator>(), 4, 0};
+
+    // Generate the chunks in different orders.
+    const auto c1 = world1.chunk(2, -3);
+    for (auto cx = -1; cx <= 1; ++cx)
+        world2.chunk(cx, 5);
+    const auto c2 = world2.chunk(2, -3);
+    REQUIRE(c1->maze == c2->maze);
+    REQUIRE(c1->doors == c2->doors);
+
+    const auto c3 = world1.generateChunk(2, -3);
+    REQUIRE(c1->maze == c3.maze);
+    REQUIRE(c1->doors == c3.doors);
+
+    maze::MazeWorld world3{seed + 1, chunkDimensions, maze::MazeWorld::factoryFor<maze::DFSMazeGenerator>()};
+    REQUIRE(!(world3.chunk(2, -3)->maze == c1->maze));
+}
+
+TEST_CASE("MazeWorld chunks agree on their shared doors and connect the world", "[maze][world]") {
+    // A checkerboard of algorithms, around the origin so that negative coordinates are included.
+    const auto factory = [](const std::int64_t cx, const std::int64_t cy, const types::Dimensions2D &d)
+            -> std::unique_ptr<maze::MazeGenerator> {
+        if ((cx + cy) % 2 == 0)
+            return std::make_unique<maze::DFSMazeGenerator>(d);
+        return std::make_unique<maze::WilsonMazeGenerator>(d);
+    };
+    maze::MazeWorld world{seed, chunkDimensions, factory, 8};
+
+    const auto [cw, ch] = chunkDimensions.values();
+    constexpr auto numChunks = 4;
+    const std::int64_t x0 = -2 * cw;
+    const std::int64_t y0 = -2 * ch;
+    for (auto y = y0; y < y0 + numChunks * ch; ++y)
+        for (auto x = x0; x < x0 + numChunks * cw; ++x) {
+            REQUIRE(world.wall(x, y, types::Direction::EAST) == world.wall(x + 1, y, types::Direction::WEST));
+            REQUIRE(world.wall(x, y, types::Direction::SOUTH) == world.wall(x, y + 1, types::Direction::NORTH));
+        }
+
+    // Every side of a chunk has exactly one door.
+    for (auto cy = -2; cy < 2; ++cy)
+        for (auto cx = -2; cx < 2; ++cx) {
+            auto eastDoors = 0;
+            for (auto y = 0; y < ch; ++y)
+                if (!world.wall((cx + 1) * cw - 1, cy * ch + y, types::Direction::EAST))
+                    ++eastDoors;
+            auto southDoors = 0;
+            for (auto x = 0; x < cw; ++x)
+                if (!world.wall(cx * cw + x, (cy + 1) * ch - 1, types::Direction::SOUTH))
+                    ++southDoors;
+            REQUIRE(eastDoors == 1);
+            REQUIRE(southDoors == 1);
+        }
+
+    // Any window aligned to the chunks is connected.
+    const auto m = window(world, x0, y0, numChunks * cw, numChunks * ch);
+    REQUIRE(m.findConnectedComponents().size() == 1);
+}
+
+TEST_CASE("MazeWorld evicts the least recently used chunks", "[maze][world]") {
+    maze::MazeWorld world{seed, chunkDimensions, maze::MazeWorld::factoryFor<maze::DFSMazeGenerator>(), 3, 0};
+    const auto c0 = world.chunk(0, 0);
+    const auto c1 = world.chunk(1, 0);
+    world.chunk(2, 0);
+    REQUIRE(world.chunk(0, 0) == c0);
+
+    // The cache is full, so (1,0) is the least recently used.
+    world.chunk(3, 0);
+    REQUIRE(world.numCachedChunks() == 3);
+    REQUIRE(world.chunk(0, 0) == c0);
+
+    const auto c1Again = world.chunk(1, 0);
+    REQUIRE(c1Again != c1);
+    REQUIRE(c1Again->maze == c1->maze);
+}
+
+TEST_CASE("MazeWorld generates chunks in the background", "[maze][world]") {
+    maze::MazeWorld world{seed, chunkDimensions, maze::MazeWorld::factoryFor<maze::WilsonMazeGenerator>(), 64, 2};
+    world.prefetch(-1, 1, 2);
+    REQUIRE(world.numCachedChunks() == 25);
+    for (auto cy = -1; cy <= 3; ++cy)
+        for (auto cx = -3; cx <= 1; ++cx)
+            REQUIRE(world.chunk(cx, cy)->maze == world.generateChunk(cx, cy).maze);
+    REQUIRE(world.numCachedChunks() == 25);
+}
+
+TEST_CASE("MazeWorld rejects invalid parameters", "[maze][world]") {
+    const auto dfs = maze::MazeWorld::factoryFor<maze::DFSMazeGenerator>();
+    REQUIRE_THROWS_AS((maze::MazeWorld{seed, types::Dimensions2D{0, 5}, dfs}), std::invalid_argument);
+    REQUIRE_THROWS_AS((maze::MazeWorld{seed, chunkDimensions, nullptr}), std::invalid_argument);
+    REQUIRE_THROWS_AS((maze::MazeWorld{seed, chunkDimensions, dfs, 0}), std::invalid_argument);
+}
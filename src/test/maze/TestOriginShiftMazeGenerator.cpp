@@ -0,0 +1,113 @@
+/**
+ * TestOriginShiftMazeGenerator.cpp
+ *
+ * By Sebastian Raaphorst, 2018.
+ *
+ * Tests that the OriginShiftMazeGenerator keeps its maze perfect and reports every wall it changes.
+ */
+
+#include <catch.hpp>
+
+#include <cstdlib>
+
+#include <types/CommonMazeAttributes.h>
+#include <types/Dimensions2D.h>
+#include <types/Direction.h>
+#include <maze/Maze.h>
+#include <maze/MazeAttributes.h>
+#include <maze/MazeGeneratorSignalDescriptors.h>
+#include <maze/OriginShiftMazeGenerator.h>
+
+using namespace spelunker;
+
+namespace {
+    bool isPerfect(const maze::Maze &m) {
+        return m.findConnectedComponents().size() == 1 && m.numCarvedWalls() == m.getWidth() * m.getHeight() - 1;
+    }
+
+    /// The wall between two adjacent cells.
+    maze::WallID wallBetween(const types::Dimensions2D &dim, const types::Cell &c1, const types::Cell &c2) {
+        const auto [x1, y1] = c1;
+        const auto [x2, y2] = c2;
+        REQUIRE(std::abs(x1 - x2) + std::abs(y1 - y2) == 1);
+        const auto d = x1 != x2 ? (x1 < x2 ? types::Direction::EAST : types::Direction::WEST)
+                                : (y1 < y2 ? types::Direction::SOUTH : types::Direction::NORTH);
+        return maze::Maze::rankPositionS(dim, x1, y1, d);
+    }
+}
+
+TEST_CASE("OriginShiftMazeGenerator keeps its maze perfect", "[maze][origin_shift]") {
+    for (const auto &[width, height]: {std::make_pair(2, 1), std::make_pair(1, 9), std::make_pair(25, 17)}) {
+        maze::OriginShiftMazeGenerator gen{width, height, 0};
+        REQUIRE(isPerfect(gen.generate()));
+        for (auto i = 0; i < 50; ++i) {
+            gen.step(7);
+            REQUIRE(isPerfect(gen.generate()));
+        }
+
+        const auto [ox, oy] = gen.getOrigin();
+        REQUIRE((0 <= ox && ox < width && 0 <= oy && oy < height));
+    }
+}
+
+TEST_CASE("OriginShiftMazeGenerator notifies observers of every changed wall", "[maze][origin_shift]") {
+    using Signals = maze::MazeGeneratorSignalDescriptors;
+    const types::Dimensions2D dim{19, 13};
+    maze::OriginShiftMazeGenerator gen{dim};
+
+    // Replay the notifications on a copy of the walls, which must then match the maze.
+    auto walls = maze::createMazeLayout(dim, true);
+    const auto initial = gen.generate();
+    for (auto y = 0; y < dim.getHeight(); ++y)
+        for (auto x = 0; x < dim.getWidth(); ++x)
+            for (const auto d: {types::Direction::EAST, types::Direction::SOUTH}) {
+                const auto w = maze::Maze::rankPositionS(dim, x, y, d);
+                if (w >= 0)
+                    walls[w] = initial.wall(x, y, d);
+            }
+
+    auto numCarved = 0;
+    auto numClosed = 0;
+    gen.connect<Signals::PassageCarved>([&](const types::Cell &c1, const types::Cell &c2) {
+        const auto w = wallBetween(dim, c1, c2);
+        REQUIRE(walls[w]);
+        walls[w] = false;
+        ++numCarved;
+    });
+    gen.connect<Signals::PassageClosed>([&](const types::Cell &c1, const types::Cell &c2) {
+        const auto w = wallBetween(dim, c1, c2);
+        REQUIRE(!walls[w]);
+        walls[w] = true;
+        ++numClosed;
+    });
+
+    for (auto i = 0; i < 100; ++i) {
+        gen.step(13);
+        REQUIRE(maze::Maze{dim, walls} == gen.generate());
+    }
+    REQUIRE(numCarved > 0);
+    REQUIRE(numCarved == numClosed);
+}
+
+TEST_CASE("OriginShiftMazeGenerator shuffles away the initial comb", "[maze][origin_shift]") {
+    // In the comb, every row but the last is a corridor leading east, with only its last cell open to the south.
+    const auto isCombRow = [](const maze::Maze &m, const int y) {
+        for (auto x = 0; x < m.getWidth(); ++x)
+            if (m.wall(x, y, types::Direction::EAST) != (x + 1 == m.getWidth())
+                || m.wall(x, y, types::Direction::SOUTH) != (x + 1 < m.getWidth()))
+                return false;
+        return true;
+    };
+
+    const maze::OriginShiftMazeGenerator gen{60, 40};
+    const auto m = gen.generate();
+    REQUIRE(isPerfect(m));
+    for (auto y = 0; y + 1 < m.getHeight(); ++y)
+        REQUIRE(!isCombRow(m, y));
+}
+
+TEST_CASE("OriginShiftMazeGenerator leaves a single cell alone", "[maze][origin_shift]") {
+    maze::OriginShiftMazeGenerator gen{1, 1};
+    gen.step(10);
+    REQUIRE(gen.getOrigin() == types::cell(0, 0));
+}
@@ -0,0 +1,65 @@
+/**
+ * TestParallelBFSMazeGenerator.cpp
+ *
+ * By Sebastian Raaphorst, 2018.
+ *
+ * Tests that the ParallelBFSMazeGenerator produces breadth-first search trees that depend only on the seed.
+ */
+
+#include <catch.hpp>
+
+#include <cstdlib>
+
+#include <types/CommonMazeAttributes.h>
+#include <types/Direction.h>
+#include <maze/Maze.h>
+#include <maze/ParallelBFSMazeGenerator.h>
+
+#include "ParallelMazeGeneratorChecks.h"
+
+using namespace spelunker;
+
+namespace {
+    /// Determine if the maze is a breadth-first search tree from some cell: every other cell has exactly one passage
+    /// leading to a cell closer to it, which also makes the maze perfect.
+    bool isBFSTree(const maze::Maze &m) {
+        const auto width = m.getWidth();
+        const auto height = m.getHeight();
+        for (auto sx = 0; sx < width; ++sx)
+            for (auto sy = 0; sy < height; ++sy) {
+                auto isTree = true;
+                for (auto x = 0; isTree && x < width; ++x)
+                    for (auto y = 0; isTree && y < height; ++y) {
+                        if (x == sx && y == sy)
+                            continue;
+                        auto numCloser = 0;
+                        for (const auto d: {types::Direction::NORTH, types::Direction::EAST,
+                                            types::Direction::SOUTH, types::Direction::WEST}) {
+                            if (m.wall(x, y, d))
+                                continue;
+                            const auto [nx, ny] = types::applyDirectionToCell(types::cell(x, y), d);
+                            if (std::abs(nx - sx) + std::abs(ny - sy) < std::abs(x - sx) + std::abs(y - sy))
+                                ++numCloser;
+                        }
+                        isTree = numCloser == 1;
+                    }
+                if (isTree)
+                    return true;
+            }
+        return false;
+    }
+}
+
+TEST_CASE("ParallelBFSMazeGenerator generates breadth-first search trees", "[maze][parallelbfs]") {
+    constexpr auto width = 31;
+    constexpr auto height = 23;
+
+    for (auto i = 0; i < 5; ++i)
+        REQUIRE(isBFSTree(maze::ParallelBFSMazeGenerator{width, height}.generate()));
+}
+
+TEST_CASE("ParallelBFSMazeGenerator generates perfect mazes that depend only on the seed", "[maze][parallelbfs]") {
+    maze::checkParallelMazeGenerator([](const int w, const int h, const unsigned int numThreads) {
+        return maze::ParallelBFSMazeGenerator{w, h, numThreads};
+    });
+}
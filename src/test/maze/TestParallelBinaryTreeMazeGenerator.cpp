@@ -0,0 +1,52 @@
+/**
+ * TestParallelBinaryTreeMazeGenerator.cpp
+ *
+ * By Sebastian Raaphorst, 2018.
+ *
+ * Tests that the ParallelBinaryTreeMazeGenerator produces perfect mazes with the right bias that depend only on the seed.
+ */
+
+#include <catch.hpp>
+
+#include <types/Direction.h>
+#include <maze/Maze.h>
+#include <maze/ParallelBinaryTreeMazeGenerator.h>
+
+#include "ParallelMazeGeneratorChecks.h"
+
+using namespace spelunker;
+
+TEST_CASE("ParallelBinaryTreeMazeGenerator generates perfect mazes of any width and probability", "[maze][parallelbinarytree]") {
+    constexpr auto height = 41;
+
+    // Try widths on either side of the word boundaries.
+    for (const auto width: {1, 63, 64, 65, 130})
+        for (const auto p: {0.0, 0.25, 0.5, 1.0}) {
+            const auto m = maze::ParallelBinaryTreeMazeGenerator{width, height, p}.generate();
+            REQUIRE(m.findConnectedComponents().size() == 1);
+            REQUIRE(m.numCarvedWalls() == width * height - 1);
+        }
+}
+
+TEST_CASE("ParallelBinaryTreeMazeGenerator carves east with the given probability", "[maze][parallelbinarytree]") {
+    constexpr auto width = 201;
+    constexpr auto height = 201;
+    constexpr auto p = 0.25;
+    const auto m = maze::ParallelBinaryTreeMazeGenerator{width, height, p}.generate(0x5eed);
+
+    // Only the cells that are not along the eastern or southern boundary have a choice.
+    auto numEast = 0;
+    for (auto y = 0; y < height - 1; ++y)
+        for (auto x = 0; x < width - 1; ++x)
+            if (!m.wall(x, y, types::Direction::EAST))
+                ++numEast;
+    const auto fraction = static_cast<double>(numEast) / ((width - 1) * (height - 1));
+    REQUIRE(fraction > p - 0.01);
+    REQUIRE(fraction < p + 0.01);
+}
+
+TEST_CASE("ParallelBinaryTreeMazeGenerator generates perfect mazes that depend only on the seed", "[maze][parallelbinarytree]") {
+    maze::checkParallelMazeGenerator([](const int w, const int h, const unsigned int numThreads) {
+        return maze::ParallelBinaryTreeMazeGenerator{w, h, 0.5, numThreads};
+    });
+}
@@ -0,0 +1,21 @@
+/**
+ * TestParallelKruskalMazeGenerator.cpp
+ *
+ * By Sebastian Raaphorst, 2018.
+ *
+ * Tests that the ParallelKruskalMazeGenerator produces perfect mazes that depend only on the seed.
+ */
+
+#include <catch.hpp>
+
+#include <maze/ParallelKruskalMazeGenerator.h>
+
+#include "ParallelMazeGeneratorChecks.h"
+
+using namespace spelunker;
+
+TEST_CASE("ParallelKruskalMazeGenerator generates perfect mazes that depend only on the seed", "[maze][parallelkruskal]") {
+    maze::checkParallelMazeGenerator([](const int w, const int h, const unsigned int numThreads) {
+        return maze::ParallelKruskalMazeGenerator{w, h, numThreads};
+    });
+}
@@ -0,0 +1,25 @@
+/**
+ * TestParallelRecursiveDivisionMazeGenerator.cpp
+ *
+ * By Sebastian Raaphorst, 2018.
+ *
+ * Tests that the ParallelRecursiveDivisionMazeGenerator produces perfect mazes that depend only on the seed.
+ */
+
+#include <catch.hpp>
+
+#include <maze/ParallelRecursiveDivisionMazeGenerator.h>
+
+#include "ParallelMazeGeneratorChecks.h"
+
+using namespace spelunker;
+
+TEST_CASE("ParallelRecursiveDivisionMazeGenerator generates perfect mazes that depend only on the seed", "[maze][parallelrecursivedivision]") {
+    // Make the maze large enough that it is divided in several tasks.
+    constexpr auto width = 300;
+    constexpr auto height = 200;
+
+    maze::checkParallelMazeGenerator([](const int w, const int h, const unsigned int numThreads) {
+        return maze::ParallelRecursiveDivisionMazeGenerator{w, h, numThreads};
+    }, width, height);
+}
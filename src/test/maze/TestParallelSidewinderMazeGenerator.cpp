@@ -0,0 +1,59 @@
+/**
+ * TestParallelSidewinderMazeGenerator.cpp
+ *
+ * By Sebastian Raaphorst, 2018.
+ *
+ * Tests that the ParallelSidewinderMazeGenerator produces perfect sidewinder mazes that depend only on the seed.
+ */
+
+#include <catch.hpp>
+
+#include <types/Direction.h>
+#include <maze/Maze.h>
+#include <maze/ParallelSidewinderMazeGenerator.h>
+
+#include "ParallelMazeGeneratorChecks.h"
+
+using namespace spelunker;
+
+TEST_CASE("ParallelSidewinderMazeGenerator generates perfect mazes of any width and probability", "[maze][parallelsidewinder]") {
+    constexpr auto height = 41;
+
+    // Try widths on either side of the word boundaries.
+    for (const auto width: {1, 63, 64, 65, 130})
+        for (const auto p: {0.0, 0.25, 0.5, 1.0}) {
+            const auto m = maze::ParallelSidewinderMazeGenerator{width, height, p}.generate();
+            REQUIRE(m.findConnectedComponents().size() == 1);
+            REQUIRE(m.numCarvedWalls() == width * height - 1);
+        }
+}
+
+TEST_CASE("ParallelSidewinderMazeGenerator carves runs", "[maze][parallelsidewinder]") {
+    constexpr auto width = 100;
+    constexpr auto height = 20;
+
+    // With p = 0, every run is a single cell, so every cell above the bottom row carves south.
+    const auto columns = maze::ParallelSidewinderMazeGenerator{width, height, 0.0}.generate();
+    for (auto y = 0; y < height - 1; ++y)
+        for (auto x = 0; x < width; ++x)
+            REQUIRE(!columns.wall(x, y, types::Direction::SOUTH));
+
+    // With p = 1, every row is a single run, which carves south exactly once.
+    const auto rows = maze::ParallelSidewinderMazeGenerator{width, height, 1.0}.generate();
+    for (auto y = 0; y < height - 1; ++y) {
+        auto numSouth = 0;
+        for (auto x = 0; x < width; ++x) {
+            if (x < width - 1)
+                REQUIRE(!rows.wall(x, y, types::Direction::EAST));
+            if (!rows.wall(x, y, types::Direction::SOUTH))
+                ++numSouth;
+        }
+        REQUIRE(numSouth == 1);
+    }
+}
+
+TEST_CASE("ParallelSidewinderMazeGenerator generates perfect mazes that depend only on the seed", "[maze][parallelsidewinder]") {
+    maze::checkParallelMazeGenerator([](const int w, const int h, const unsigned int numThreads) {
+        return maze::ParallelSidewinderMazeGenerator{w, h, 0.5, numThreads};
+    });
+}
@@ -0,0 +1,51 @@
+/**
+ * TestProppWilsonMazeGenerator.cpp
+ *
+ * By Sebastian Raaphorst, 2018.
+ *
+ * Tests that the ProppWilsonMazeGenerator produces uniformly distributed perfect mazes that depend only on the seed.
+ */
+
+#include <catch.hpp>
+
+#include <cstdint>
+#include <map>
+#include <vector>
+
+#include <types/Direction.h>
+#include <maze/Maze.h>
+#include <maze/ProppWilsonMazeGenerator.h>
+
+#include "ParallelMazeGeneratorChecks.h"
+
+using namespace spelunker;
+
+TEST_CASE("ProppWilsonMazeGenerator generates perfect mazes that depend only on the seed", "[maze][proppwilson]") {
+    maze::checkParallelMazeGenerator([](const int w, const int h, const unsigned int numThreads) {
+        return maze::ProppWilsonMazeGenerator{w, h, numThreads};
+    });
+}
+
+TEST_CASE("ProppWilsonMazeGenerator samples spanning trees uniformly", "[maze][proppwilson]") {
+    // A 3x2 grid has exactly 15 spanning trees.
+    constexpr auto numTrees = 15;
+    constexpr auto samples = 15000;
+    const maze::ProppWilsonMazeGenerator gen{3, 2, 1};
+
+    std::map<std::vector<bool>, int> counts;
+    for (std::uint64_t seed = 0; seed < samples; ++seed) {
+        const auto m = gen.generate(seed);
+        std::vector<bool> walls;
+        for (auto y = 0; y < 2; ++y)
+            for (auto x = 0; x < 3; ++x)
+                for (const auto d: {types::Direction::EAST, types::Direction::SOUTH})
+                    walls.emplace_back(m.wall(x, y, d));
+        ++counts[walls];
+    }
+
+    REQUIRE(counts.size() == numTrees);
+    for (const auto &[walls, count]: counts) {
+        REQUIRE(count > 800);
+        REQUIRE(count < 1200);
+    }
+}
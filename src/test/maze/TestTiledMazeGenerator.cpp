@@ -0,0 +1,79 @@
+/**
+ * TestTiledMazeGenerator.cpp
+ *
+ * By Sebastian Raaphorst, 2018.
+ *
+ * Tests that the TiledMazeGenerator stitches tiles into perfect mazes that depend only on the seed.
+ */
+
+#include <catch.hpp>
+
+#include <memory>
+#include <stdexcept>
+
+#include <types/Dimensions2D.h>
+#include <types/Direction.h>
+#include <maze/DFSMazeGenerator.h>
+#include <maze/Maze.h>
+#include <maze/MazeGenerator.h>
+#include <maze/TiledMazeGenerator.h>
+#include <maze/WilsonMazeGenerator.h>
+
+#include "MazeGenerators.h"
+#include "ParallelMazeGeneratorChecks.h"
+
+using namespace spelunker;
+
+namespace {
+    /// A checkerboard of tiles generated with depth-first search and Wilson's algorithm.
+    std::unique_ptr<maze::MazeGenerator> checkerboard(const int column, const int row, const types::Dimensions2D &d) {
+        if ((column + row) % 2 == 0)
+            return std::make_unique<maze::DFSMazeGenerator>(d);
+        return std::make_unique<maze::WilsonMazeGenerator>(d);
+    }
+}
+
+TEST_CASE("TiledMazeGenerator generates perfect mazes for any tiling", "[maze][tiled]") {
+    constexpr auto width = 43;
+    constexpr auto height = 31;
+
+    // Include tilings that do not divide the maze evenly, and a single tile.
+    for (const auto &[tileWidth, tileHeight]: {std::make_pair(8, 8), std::make_pair(7, 5),
+                                               std::make_pair(1, 3), std::make_pair(60, 60)}) {
+        const auto m = maze::TiledMazeGenerator{width, height, tileWidth, tileHeight, checkerboard}.generate();
+        REQUIRE(m.findConnectedComponents().size() == 1);
+        REQUIRE(m.numCarvedWalls() == width * height - 1);
+    }
+}
+
+TEST_CASE("TiledMazeGenerator keeps the walls generated inside each tile", "[maze][tiled]") {
+    constexpr auto width = 23;
+    constexpr auto height = 17;
+    constexpr auto tileWidth = 6;
+    constexpr auto tileHeight = 4;
+    const auto m = maze::TiledMazeGenerator{width, height, tileWidth, tileHeight,
+                                            maze::TiledMazeGenerator::factoryFor<maze::CombMazeGenerator>()}.generate();
+    REQUIRE(m.numCarvedWalls() == width * height - 1);
+
+    // Every tile is a comb: a passage along its top row, with a passage down from every cell of it.
+    for (auto y = 0; y < height; ++y)
+        for (auto x = 0; x < width; ++x) {
+            if ((x + 1) % tileWidth != 0 && x + 1 < width)
+                REQUIRE(m.wall(x, y, types::Direction::EAST) == (y % tileHeight != 0));
+            if ((y + 1) % tileHeight != 0 && y + 1 < height)
+                REQUIRE(!m.wall(x, y, types::Direction::SOUTH));
+        }
+}
+
+TEST_CASE("TiledMazeGenerator generates perfect mazes that depend only on the seed", "[maze][tiled]") {
+    maze::checkParallelMazeGenerator([](const int w, const int h, const unsigned int numThreads) {
+        return maze::TiledMazeGenerator{w, h, 16, 16, checkerboard, numThreads};
+    });
+}
+
+TEST_CASE("TiledMazeGenerator rejects invalid tilings", "[maze][tiled]") {
+    const auto dfs = maze::TiledMazeGenerator::factoryFor<maze::DFSMazeGenerator>();
+    REQUIRE_THROWS_AS((maze::TiledMazeGenerator{10, 10, 0, 5, dfs}), std::invalid_argument);
+    REQUIRE_THROWS_AS((maze::TiledMazeGenerator{10, 10, 5, 0, dfs}), std::invalid_argument);
+    REQUIRE_THROWS_AS((maze::TiledMazeGenerator{10, 10, 5, 5, nullptr}), std::invalid_argument);
+}
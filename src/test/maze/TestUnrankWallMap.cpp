@@ -3,13 +3,15 @@
  *
  * By Sebastian Raaphorst, 2018.
  *
- * Tests the @see{spelunker::maze::MazeGenerator::createUnrankWallMapS} function that
- * unranks WallIds into pairs of positions.
+ * Tests the @see{spelunker::maze::MazeGenerator::createUnrankWallMapS} and @see{spelunker::maze::unrankWall}
+ * functions that unrank WallIds into pairs of positions.
  */
 
 #include <catch.hpp>
 
 #include <types/Dimensions2D.h>
+#include <types/Direction.h>
+#include <maze/MazeAttributes.h>
 #include <maze/Maze.h>
 #include <maze/MazeGenerator.h>
 
@@ -37,4 +39,20 @@ TEST_CASE("Unranking map from wall ranks to pairs of adjacent positions", "[maze
             REQUIRE(maze::Maze::rankPositionS(dim, x2, y2, d2) == rk);
         }
     }
-}
\ No newline at end of file
+
+    SECTION("Every position facing an interior wall is one of the positions the wall unranks to") {
+        for (auto x = 0; x < width; ++x)
+            for (auto y = 0; y < height; ++y)
+                for (const auto d : types::directions()) {
+                    const auto rk = maze::Maze::rankPositionS(dim, x, y, d);
+                    if (rk == -1) continue;
+                    const auto [p1, p2] = maze::unrankWall(width, height, rk);
+                    REQUIRE((p1 == types::pos(x, y, d) || p2 == types::pos(x, y, d)));
+                    REQUIRE(m.at(rk) == std::make_pair(p1, p2));
+                }
+    }
+}
+
+// unrankWall can be evaluated at compile time.
+static_assert(maze::unrankWall(3, 2, 1).second == types::Position{{1, 1}, types::Direction::NORTH});
+static_assert(maze::unrankWall(3, 2, 4).first == types::Position{{0, 1}, types::Direction::EAST});
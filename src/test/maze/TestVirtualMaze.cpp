@@ -0,0 +1,80 @@
+/**
+ * TestVirtualMaze.cpp
+ *
+ * By Sebastian Raaphorst, 2018.
+ *
+ * Tests that virtual mazes compute the walls of the mazes generated by their generators, at any size.
+ */
+
+#include <catch.hpp>
+
+#include <climits>
+#include <cstdint>
+
+#include <typeclasses/Show.h>
+#include <types/CommonMazeAttributes.h>
+#include <types/Direction.h>
+#include <maze/Maze.h>
+#include <maze/MazeTypeclasses.h>
+#include <maze/ParallelBinaryTreeMazeGenerator.h>
+#include <maze/ParallelSidewinderMazeGenerator.h>
+#include <maze/VirtualMaze.h>
+
+using namespace spelunker;
+
+namespace {
+    constexpr std::uint64_t seed = 0x71a7;
+
+    /// Check that the walls of a virtual maze agree between neighbouring cells around a cell.
+    void checkConsistent(const maze::VirtualMaze &m, const int x, const int y) {
+        if (x + 1 < m.getWidth())
+            REQUIRE(m.wall(x, y, types::Direction::EAST) == m.wall(x + 1, y, types::Direction::WEST));
+        if (y + 1 < m.getHeight())
+            REQUIRE(m.wall(x, y, types::Direction::SOUTH) == m.wall(x, y + 1, types::Direction::NORTH));
+        REQUIRE(m.numCellWalls(types::cell(x, y)) + m.neighbours(types::cell(x, y)).size() == 4);
+    }
+}
+
+TEST_CASE("Virtual binary tree mazes match the parallel binary tree generator", "[maze][virtual]") {
+    for (const auto &[width, height]: {std::make_pair(150, 40), std::make_pair(64, 3), std::make_pair(65, 2),
+                                       std::make_pair(1, 10), std::make_pair(10, 1)})
+        for (const auto p: {0.2, 0.5, 0.9}) {
+            const maze::VirtualBinaryTreeMaze vm{width, height, seed, p};
+            const auto m = maze::ParallelBinaryTreeMazeGenerator{width, height, p}.generate(seed);
+            REQUIRE(vm.window(0, 0, width, height) == m);
+            REQUIRE(vm.findConnectedComponents().size() == 1);
+        }
+}
+
+TEST_CASE("Virtual sidewinder mazes match the parallel sidewinder generator", "[maze][virtual]") {
+    for (const auto &[width, height]: {std::make_pair(150, 40), std::make_pair(64, 3), std::make_pair(65, 2),
+                                       std::make_pair(1, 10), std::make_pair(10, 1)})
+        for (const auto p: {0.2, 0.5, 0.98}) {
+            const maze::VirtualSidewinderMaze vm{width, height, seed, p};
+            const auto m = maze::ParallelSidewinderMazeGenerator{width, height, p}.generate(seed);
+            REQUIRE(vm.window(0, 0, width, height) == m);
+            REQUIRE(vm.findConnectedComponents().size() == 1);
+        }
+}
+
+TEST_CASE("Virtual mazes can be rendered directly", "[maze][virtual]") {
+    const maze::VirtualSidewinderMaze vm{30, 12, seed};
+    REQUIRE(typeclasses::Show<maze::VirtualMaze>::show(vm) ==
+            typeclasses::Show<maze::Maze>::show(vm.window(0, 0, 30, 12)));
+}
+
+TEST_CASE("Virtual mazes of the largest dimensions can be queried anywhere", "[maze][virtual]") {
+    const maze::VirtualBinaryTreeMaze bt{INT_MAX, INT_MAX, seed};
+    const maze::VirtualSidewinderMaze sw{INT_MAX, INT_MAX, seed};
+    for (const auto x: {0, 1, 63, 64, 1 << 20, INT_MAX - 65, INT_MAX - 2})
+        for (const auto y: {0, 5, 1 << 30, INT_MAX - 2}) {
+            checkConsistent(bt, x, y);
+            checkConsistent(sw, x, y);
+        }
+
+    // In the binary tree, every cell carves east or south towards the southeast corner, so a window in that corner
+    // is itself a perfect maze.
+    const auto m = bt.window(INT_MAX - 100, INT_MAX - 100, 100, 100);
+    REQUIRE(m.numCarvedWalls() == 100 * 100 - 1);
+    REQUIRE(m.findConnectedComponents().size() == 1);
+}
@@ -6,6 +6,13 @@
 
 #include <catch.hpp>
 
+#include <algorithm>
+#include <map>
+#include <set>
+#include <tuple>
+
+#include <boost/graph/adjacency_list.hpp>
+
 #include <maze/DFSMazeGenerator.h>
 #include <maze/Maze.h>
 #include <squashedmaze/SquashedMazeAttributes.h>
@@ -24,4 +31,45 @@ TEST_CASE("SquashedMaze should process a Maze", "[squashedmaze][maze]") {
     const auto &mp = sm.getEdgeMap();
     const auto &g = sm.getGraph();
     REQUIRE(true == true);
-}
\ No newline at end of file
+}
+
+namespace {
+    /// Describe a SquashedMaze by its edges in terms of cells and weights, independently of vertex numbering.
+    std::set<std::tuple<types::Cell, types::Cell, int>> squashedEdges(const squashedmaze::SquashedMaze &sm) {
+        std::map<squashedmaze::WeightedGraphVertex, types::Cell> cells;
+        for (const auto &[c, v]: sm.getVertexMap())
+            cells[v] = c;
+
+        std::set<std::tuple<types::Cell, types::Cell, int>> result;
+        const auto &g = sm.getGraph();
+        for (auto [ei, eend] = boost::edges(g); ei != eend; ++ei) {
+            const auto [c1, c2] = std::minmax(cells[boost::source(*ei, g)], cells[boost::target(*ei, g)]);
+            result.emplace(c1, c2, boost::get(boost::edge_weight, g, *ei));
+        }
+        return result;
+    }
+}
+
+TEST_CASE("SquashedMaze built with multiple threads should match the sequential construction", "[squashedmaze][maze][parallel]") {
+    constexpr auto width = 50;
+    constexpr auto height = 40;
+    const maze::DFSMazeGenerator dfs{width, height};
+
+    SECTION("Perfect maze") {
+        const auto m = dfs.generate();
+        const auto sequential = squashedmaze::SquashedMaze(m);
+        const auto parallel = squashedmaze::SquashedMaze(m, 4);
+        REQUIRE(sequential.getVertexMap() == parallel.getVertexMap());
+        REQUIRE(squashedEdges(sequential) == squashedEdges(parallel));
+    }
+
+    SECTION("Braided maze") {
+        const auto m = dfs.generate().braid(0.5);
+        const auto sequential = squashedmaze::SquashedMaze(m);
+        for (auto numThreads: {2u, 3u, 8u}) {
+            const auto parallel = squashedmaze::SquashedMaze(m, numThreads);
+            REQUIRE(sequential.getVertexMap() == parallel.getVertexMap());
+            REQUIRE(squashedEdges(sequential) == squashedEdges(parallel));
+        }
+    }
+}
@@ -0,0 +1,170 @@
+/**
+ * TestCellularAutomatonThickMazeGenerator.cpp
+ *
+ * By Sebastian Raaphorst, 2018.
+ *
+ * Tests the bit-sliced engine of the CellularAutomatonThickMazeGenerator against a cell by cell simulation, and
+ * its detection of cycles, including ones far longer than a window of recent generations would catch.
+ */
+
+#include <catch.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <map>
+#include <tuple>
+#include <utility>
+
+#include <types/Dimensions2D.h>
+#include <types/Exceptions.h>
+#include <thickmaze/CellularAutomatonThickMazeGenerator.h>
+#include <thickmaze/ThickMaze.h>
+#include <thickmaze/ThickMazeAttributes.h>
+
+using namespace spelunker;
+using Generator = thickmaze::CellularAutomatonThickMazeGenerator;
+
+namespace {
+    /// Compute the next generation one cell at a time, on a torus.
+    thickmaze::CellContents nextGeneration(const thickmaze::CellContents &cs, const Generator::settings &st) {
+        const auto width = static_cast<int>(cs.size());
+        const auto height = static_cast<int>(cs[0].size());
+        const auto isWall = [&](const int x, const int y) {
+            return cs[((x % width) + width) % width][((y % height) + height) % height] == thickmaze::CellType::WALL;
+        };
+
+        auto next = thickmaze::createThickMazeLayout(width, height);
+        for (auto y = 0; y < height; ++y)
+            for (auto x = 0; x < width; ++x) {
+                auto count = 0;
+                if (st.neighbourhoodType == Generator::MOORE) {
+                    for (auto dy = -1; dy <= 1; ++dy)
+                        for (auto dx = -1; dx <= 1; ++dx)
+                            if ((dx != 0 || dy != 0) && isWall(x + dx, y + dy))
+                                ++count;
+                } else {
+                    for (const auto d: {-2, -1, 1, 2})
+                        count += isWall(x + d, y) + isWall(x, y + d);
+                }
+
+                const auto mask = isWall(x, y) ? st.rule.survive : st.rule.born;
+                if (mask & (1u << static_cast<unsigned int>(count)))
+                    next[x][y] = thickmaze::CellType::WALL;
+            }
+        return next;
+    }
+
+    thickmaze::CellContents contentsOf(const thickmaze::ThickMaze &tm) {
+        auto cs = thickmaze::createThickMazeLayout(tm.getWidth(), tm.getHeight());
+        for (auto x = 0; x < tm.getWidth(); ++x)
+            for (auto y = 0; y < tm.getHeight(); ++y)
+                cs[x][y] = tm.cellIs(x, y);
+        return cs;
+    }
+}
+
+TEST_CASE("CellularAutomatonThickMazeGenerator computes generations correctly", "[thickmaze][cellularautomaton]") {
+    // Widths around the word size, and grids small enough for the neighbourhoods to wrap onto themselves.
+    for (const auto &[width, height]: {std::make_pair(70, 9), std::make_pair(64, 5), std::make_pair(130, 4),
+                                       std::make_pair(3, 2), std::make_pair(1, 5), std::make_pair(2, 1)})
+        for (const auto neighbourhoodType: {Generator::MOORE, Generator::VON_NEUMANN_EXTENDED})
+            for (const auto algorithm: {Generator::MAZECTRIC, Generator::MAZE, Generator::VOTE45,
+                                        Generator::VOTE, Generator::B2S123}) {
+                Generator::settings st;
+                st.neighbourhoodType = neighbourhoodType;
+                st.rule = Generator::fromAlgorithm(algorithm);
+                st.numThreads = 3;
+
+                // Advance one generation at a time, checking each against the simulation.
+                const auto stepper = Generator{width, height, st}.stepper();
+                for (auto generation = 0; generation < 5 && !stepper->isDone(); ++generation) {
+                    const auto expected = nextGeneration(contentsOf(stepper->current()), st);
+                    stepper->advance(height);
+                    REQUIRE(contentsOf(stepper->current()) == expected);
+                }
+            }
+}
+
+TEST_CASE("CellularAutomatonThickMazeGenerator compiles behaviours into rules", "[thickmaze][cellularautomaton]") {
+    // B3/S1234, as MAZECTRIC.
+    const auto rule = Generator::fromBehaviour([](const int num, const thickmaze::CellType ct) {
+        if (num >= 1 && num <= 4 && ct == thickmaze::CellType::WALL) return Generator::SURVIVE;
+        if (num == 3 && ct == thickmaze::CellType::FLOOR) return Generator::BORN;
+        return Generator::DIE;
+    });
+    const auto expected = Generator::fromAlgorithm(Generator::MAZECTRIC);
+    REQUIRE(rule.born == expected.born);
+    REQUIRE(rule.survive == expected.survive);
+}
+
+TEST_CASE("CellularAutomatonThickMazeGenerator stops once a generation repeats", "[thickmaze][cellularautomaton]") {
+    constexpr auto width = 75;
+    constexpr auto height = 40;
+    constexpr auto allCounts = std::uint16_t{0x1ff};
+
+    for (const auto rule: {
+            // Every floor is born and every wall dies, so the generations alternate.
+            Generator::Rule{allCounts, 0},
+            // Everything dies, reaching a fixed point.
+            Generator::Rule{0, 0}}) {
+        Generator::settings st;
+        st.rule = rule;
+        const auto stepper = Generator{width, height, st}.stepper();
+        stepper->finish();
+        REQUIRE(stepper->getNumSteps() <= 4 * height);
+
+        // The final generation is part of the cycle.
+        const auto last = stepper->current();
+        const auto next = nextGeneration(contentsOf(last), st);
+        REQUIRE((next == contentsOf(last) || nextGeneration(next, st) == contentsOf(last)));
+    }
+}
+
+TEST_CASE("CellularAutomatonThickMazeGenerator finds long cycles", "[thickmaze][cellularautomaton]") {
+    // A glider under B3/S23 moves one cell diagonally every four generations, so on a torus it returns to where it
+    // started after 4 * lcm(width, height) generations: here, 480.
+    constexpr auto width = 24;
+    constexpr auto height = 20;
+    constexpr auto period = 480;
+
+    Generator::settings st;
+    st.rule = Generator::Rule{1u << 3u, (1u << 2u) | (1u << 3u)};
+
+    auto glider = thickmaze::createThickMazeLayout(width, height);
+    for (const auto &[x, y]: {std::make_pair(1, 0), std::make_pair(2, 1), std::make_pair(0, 2),
+                              std::make_pair(1, 2), std::make_pair(2, 2)})
+        glider[x][y] = thickmaze::CellType::WALL;
+
+    // Find the generation at which the cycle starts, and its length, by simulation.
+    std::map<thickmaze::CellContents, int> seen;
+    auto cs = glider;
+    auto generation = 0;
+    for (; seen.find(cs) == seen.end(); ++generation) {
+        seen.emplace(cs, generation);
+        cs = nextGeneration(cs, st);
+    }
+    const auto mu = seen[cs];
+    const auto lambda = generation - mu;
+    REQUIRE(mu == 0);
+    REQUIRE(lambda == period);
+
+    // Brent's algorithm compares against generations 2^k - 1, and stops once the first of these at or after mu
+    // recurs, after fewer than 2 * max(mu + 1, lambda) + lambda generations.
+    const Generator gen{width, height, st};
+    const auto stepper = gen.stepper(thickmaze::ThickMaze{types::Dimensions2D{width, height}, glider});
+    stepper->finish();
+    const auto numGenerations = static_cast<int>(stepper->getNumSteps() / height);
+    REQUIRE(numGenerations >= mu + lambda);
+    REQUIRE(numGenerations < 2 * std::max(mu + 1, lambda) + lambda);
+    REQUIRE(numGenerations < st.numGenerations);
+
+    // The final generation is part of the cycle.
+    const auto last = contentsOf(stepper->current());
+    REQUIRE(seen.find(last) != seen.end());
+    REQUIRE(seen[last] >= mu);
+}
+
+TEST_CASE("CellularAutomatonThickMazeGenerator rejects initial grids of the wrong dimensions", "[thickmaze][cellularautomaton]") {
+    const thickmaze::ThickMaze tm{types::Dimensions2D{10, 5}, thickmaze::createThickMazeLayout(10, 5)};
+    REQUIRE_THROWS_AS(Generator(5, 10).stepper(tm), types::IllegalDimensions);
+}
@@ -0,0 +1,128 @@
+/**
+ * TestChokePoints.cpp
+ *
+ * By Sebastian Raaphorst, 2018.
+ *
+ * Tests that the choke points of mazes agree with a brute force search.
+ */
+
+#include <catch.hpp>
+
+#include <algorithm>
+#include <map>
+#include <queue>
+#include <utility>
+#include <vector>
+
+#include <types/AbstractMaze.h>
+#include <types/CommonMazeAttributes.h>
+#include <maze/DFSMazeGenerator.h>
+#include <maze/Maze.h>
+#include <thickmaze/CellularAutomatonThickMazeGenerator.h>
+#include <thickmaze/ThickMaze.h>
+
+using namespace spelunker;
+
+namespace {
+    using Edge = std::pair<types::Cell, types::Cell>;
+
+    /// Count the components of the maze, ignoring the removed cell and the removed passage.
+    int countComponents(const types::AbstractMaze &m, const types::Cell &removedCell, const Edge &removedEdge) {
+        auto visited = types::initializeCellIndicator(m.getWidth(), m.getHeight());
+        const auto skip = [&](const types::Cell &a, const types::Cell &b) {
+            return b == removedCell || Edge{a, b} == removedEdge || Edge{b, a} == removedEdge;
+        };
+
+        auto count = 0;
+        for (auto y = 0; y < m.getHeight(); ++y)
+            for (auto x = 0; x < m.getWidth(); ++x) {
+                const auto c = types::cell(x, y);
+                if (visited[x][y] || c == removedCell || !m.cellInBounds(c)) continue;
+                ++count;
+                std::queue<types::Cell> queue;
+                queue.emplace(c);
+                visited[x][y] = true;
+                while (!queue.empty()) {
+                    const auto cur = queue.front();
+                    queue.pop();
+                    for (const auto &n: m.neighbours(cur)) {
+                        if (visited[n.first][n.second] || skip(cur, n)) continue;
+                        visited[n.first][n.second] = true;
+                        queue.emplace(n);
+                    }
+                }
+            }
+        return count;
+    }
+
+    /// Check the choke points of a maze by removing every cell and every passage in turn.
+    void checkChokePoints(const types::AbstractMaze &m) {
+        const auto chokePoints = m.findChokePoints();
+        const types::Cell none{-1, -1};
+        const auto baseline = countComponents(m, none, Edge{none, none});
+
+        std::map<types::Cell, int> numComponents;
+        for (const auto &comp: chokePoints.biconnectedComponents) {
+            REQUIRE(comp.size() >= 2);
+            for (const auto &c: comp)
+                ++numComponents[c];
+        }
+
+        for (auto y = 0; y < m.getHeight(); ++y)
+            for (auto x = 0; x < m.getWidth(); ++x) {
+                const auto c = types::cell(x, y);
+                if (!m.cellInBounds(c)) continue;
+                const auto nbrs = m.neighbours(c);
+
+                // Removing a cell without passages removes its component, so it is never an articulation cell.
+                const auto isArticulation = !nbrs.empty() && countComponents(m, c, Edge{none, none}) > baseline;
+                const auto &ac = chokePoints.articulationCells;
+                REQUIRE((std::find(ac.cbegin(), ac.cend(), c) != ac.cend()) == isArticulation);
+                REQUIRE((numComponents[c] > 1) == isArticulation);
+
+                for (const auto &n: nbrs) {
+                    if (n < c) continue;
+                    const auto isBridge = countComponents(m, none, Edge{c, n}) > baseline;
+                    const auto &br = chokePoints.bridges;
+                    const auto found = std::count(br.cbegin(), br.cend(), Edge{c, n})
+                                       + std::count(br.cbegin(), br.cend(), Edge{n, c});
+                    REQUIRE(found == (isBridge ? 1 : 0));
+
+                    // Every passage lies in exactly one biconnected component.
+                    const auto containing = std::count_if(
+                            chokePoints.biconnectedComponents.cbegin(), chokePoints.biconnectedComponents.cend(),
+                            [&](const types::ConnectedComponent &comp) {
+                                return std::find(comp.cbegin(), comp.cend(), c) != comp.cend()
+                                       && std::find(comp.cbegin(), comp.cend(), n) != comp.cend();
+                            });
+                    REQUIRE(containing == 1);
+                }
+            }
+    }
+}
+
+TEST_CASE("Every passage of a perfect maze is a bridge", "[maze][chokepoints]") {
+    const maze::DFSMazeGenerator gen{15, 12};
+    const auto m = gen.generate();
+    const auto chokePoints = m.findChokePoints();
+    REQUIRE(static_cast<int>(chokePoints.bridges.size()) == m.numCarvedWalls());
+    REQUIRE(chokePoints.biconnectedComponents.size() == chokePoints.bridges.size());
+}
+
+TEST_CASE("Choke points of a braided Maze", "[maze][chokepoints]") {
+    const maze::DFSMazeGenerator gen{15, 12};
+    for (const auto probability: {0.1, 0.3, 0.6})
+        checkChokePoints(gen.generate().braid(probability));
+}
+
+TEST_CASE("Choke points of a ThickMaze cave", "[thickmaze][chokepoints]") {
+    thickmaze::CellularAutomatonThickMazeGenerator gen{25, 20};
+    checkChokePoints(gen.generate());
+}
+
+TEST_CASE("Choke points of a large maze do not exhaust the stack", "[maze][chokepoints]") {
+    // A DFS maze this size has paths far longer than a recursive search could follow.
+    const maze::DFSMazeGenerator gen{400, 400};
+    const auto m = gen.generate();
+    REQUIRE(static_cast<int>(m.findChokePoints().bridges.size()) == m.numCarvedWalls());
+}
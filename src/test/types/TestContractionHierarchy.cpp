@@ -0,0 +1,89 @@
+/**
+ * TestContractionHierarchy.cpp
+ *
+ * By Sebastian Raaphorst, 2018.
+ *
+ * Tests the ContractionHierarchy shortest path queries against BFS.
+ */
+
+#include <catch.hpp>
+
+#include <algorithm>
+#include <vector>
+
+#include <types/AbstractMaze.h>
+#include <types/CommonMazeAttributes.h>
+#include <types/ContractionHierarchy.h>
+#include <maze/DFSMazeGenerator.h>
+#include <maze/Maze.h>
+#include <thickmaze/CellularAutomatonThickMazeGenerator.h>
+#include <thickmaze/ThickMaze.h>
+
+using namespace spelunker;
+
+namespace {
+    /// Compare the hierarchy against BFS from a sample of the cells to all the cells of the maze.
+    void checkAgainstBFS(const types::AbstractMaze &m, const types::ContractionHierarchy &ch) {
+        const auto width = m.getWidth();
+        const auto height = m.getHeight();
+
+        for (auto y = 0; y < height; y += 7) {
+            for (auto x = 0; x < width; x += 5) {
+                const auto from = types::cell(x, y);
+                if (!m.cellInBounds(from)) continue;
+
+                // Record the BFS distances, leaving unreachable cells as -1.
+                std::vector<std::vector<int>> expected(width, std::vector<int>(height, -1));
+                const auto bfsResults = m.performBFSFrom(from);
+                for (auto d = 0; d < static_cast<int>(bfsResults.distances.size()); ++d)
+                    for (const auto &[cx, cy]: bfsResults.distances[d])
+                        expected[cx][cy] = d;
+
+                for (auto ty = 0; ty < height; ++ty) {
+                    for (auto tx = 0; tx < width; ++tx) {
+                        const auto to = types::cell(tx, ty);
+                        REQUIRE(ch.distance(from, to) == expected[tx][ty]);
+                    }
+                }
+
+                // Paths must be unpacked into adjacent cells of the maze.
+                const auto to = bfsResults.connectedCells.back();
+                const auto path = ch.shortestPath(from, to);
+                REQUIRE(path.size() == expected[to.first][to.second] + 1);
+                REQUIRE(path.front() == from);
+                REQUIRE(path.back() == to);
+                for (auto i = 0; i + 1 < static_cast<int>(path.size()); ++i) {
+                    const auto nbrs = m.neighbours(path[i]);
+                    REQUIRE(std::find(nbrs.cbegin(), nbrs.cend(), path[i + 1]) != nbrs.cend());
+                }
+            }
+        }
+    }
+}
+
+TEST_CASE("ContractionHierarchy over a braided Maze", "[maze][contractionhierarchy]") {
+    constexpr auto width = 50;
+    constexpr auto height = 40;
+    const maze::DFSMazeGenerator gen{width, height};
+    const auto m = gen.generate().braid(0.5);
+
+    SECTION("Single threaded") {
+        const types::ContractionHierarchy ch{m, 1};
+        checkAgainstBFS(m, ch);
+    }
+
+    SECTION("Multithreaded") {
+        const types::ContractionHierarchy ch{m, 4};
+        checkAgainstBFS(m, ch);
+    }
+}
+
+TEST_CASE("ContractionHierarchy over a ThickMaze cave", "[thickmaze][contractionhierarchy]") {
+    constexpr auto width = 50;
+    constexpr auto height = 40;
+    thickmaze::CellularAutomatonThickMazeGenerator gen{width, height};
+    const auto tm = gen.generate();
+
+    const types::ContractionHierarchy ch{tm};
+    checkAgainstBFS(tm, ch);
+}
@@ -0,0 +1,52 @@
+/**
+ * TestDisjointSets.cpp
+ *
+ * By Sebastian Raaphorst, 2018.
+ *
+ * Tests the DisjointSets union-find structure against a naive labelling.
+ */
+
+#include <catch.hpp>
+
+#include <algorithm>
+#include <vector>
+
+#include <math/RNG.h>
+#include <types/DisjointSets.h>
+
+using namespace spelunker;
+
+TEST_CASE("DisjointSets agree with a naive labelling", "[types][disjointsets]") {
+    constexpr auto n = 500;
+    types::DisjointSets dsets(n);
+    REQUIRE(dsets.getNumElements() == n);
+    REQUIRE(dsets.getNumSets() == n);
+
+    // Keep an explicit label for each element, relabelling one whole set on every union.
+    std::vector<int> labels(n);
+    for (auto i = 0; i < n; ++i)
+        labels[i] = i;
+
+    for (auto i = 0; i < 2 * n; ++i) {
+        const auto x = math::RNG::randomRange(n);
+        const auto y = math::RNG::randomRange(n);
+        const auto lx = labels[x];
+        const auto ly = labels[y];
+
+        REQUIRE(dsets.unite(x, y) == (lx != ly));
+        if (lx != ly)
+            std::replace(labels.begin(), labels.end(), ly, lx);
+
+        REQUIRE(dsets.connected(x, y));
+        REQUIRE(dsets.setSize(x) == std::count(labels.cbegin(), labels.cend(), lx));
+    }
+
+    std::vector<int> distinct{labels};
+    std::sort(distinct.begin(), distinct.end());
+    distinct.erase(std::unique(distinct.begin(), distinct.end()), distinct.end());
+    REQUIRE(dsets.getNumSets() == static_cast<int>(distinct.size()));
+
+    for (auto x = 0; x < n; ++x)
+        for (auto y = x; y < n; y += 7)
+            REQUIRE(dsets.connected(x, y) == (labels[x] == labels[y]));
+}
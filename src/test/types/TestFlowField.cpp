@@ -0,0 +1,136 @@
+/**
+ * TestFlowField.cpp
+ *
+ * By Sebastian Raaphorst, 2018.
+ *
+ * Tests that FlowFields agree with BFS, whether built in parallel or updated incrementally.
+ */
+
+#include <catch.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include <math/RNG.h>
+#include <types/AbstractMaze.h>
+#include <types/CommonMazeAttributes.h>
+#include <types/Direction.h>
+#include <types/Exceptions.h>
+#include <types/FlowField.h>
+#include <maze/DFSMazeGenerator.h>
+#include <maze/Maze.h>
+#include <thickmaze/CellularAutomatonThickMazeGenerator.h>
+#include <thickmaze/ThickMaze.h>
+
+using namespace spelunker;
+
+namespace {
+    /// Pick some random goal cells.
+    types::CellCollection randomGoals(const types::AbstractMaze &m, int numGoals) {
+        types::CellCollection goals;
+        for (auto i = 0; i < numGoals; ++i)
+            goals.emplace_back(types::cell(math::RNG::randomRange(m.getWidth()),
+                                           math::RNG::randomRange(m.getHeight())));
+        return goals;
+    }
+
+    /// Check a flow field against a BFS from each of its goals, and check that its directions lead downhill.
+    template<typename Distance>
+    void checkFlowField(const types::AbstractMaze &m, const types::FlowField<Distance> &ff) {
+        const auto width = m.getWidth();
+        const auto height = m.getHeight();
+        std::vector<Distance> expected(width * height, types::FlowField<Distance>::Unreachable);
+        for (const auto &g: ff.getGoals()) {
+            expected[g.second * width + g.first] = 0;
+            if (!m.cellInBounds(g)) continue;
+            const auto bfsResults = m.performBFSFrom(g);
+            for (auto d = 0; d < static_cast<int>(bfsResults.distances.size()); ++d)
+                for (const auto &[x, y]: bfsResults.distances[d])
+                    expected[y * width + x] = std::min(expected[y * width + x], static_cast<Distance>(d));
+        }
+        REQUIRE(ff.getDistances() == expected);
+
+        for (auto y = 0; y < height; ++y)
+            for (auto x = 0; x < width; ++x) {
+                const auto d = ff.distance(x, y);
+                if (d == 0 || d == types::FlowField<Distance>::Unreachable) continue;
+                const auto next = types::applyDirectionToCell(types::cell(x, y), ff.direction(x, y));
+                const auto nbrs = m.neighbours(types::cell(x, y));
+                REQUIRE(std::find(nbrs.cbegin(), nbrs.cend(), next) != nbrs.cend());
+                REQUIRE(ff.distance(next) == d - 1);
+            }
+    }
+}
+
+TEST_CASE("FlowField over a braided Maze", "[maze][flowfield]") {
+    constexpr auto width = 50;
+    constexpr auto height = 40;
+    const maze::DFSMazeGenerator gen{width, height};
+    const auto m = gen.generate().braid(0.5);
+
+    const auto goals = randomGoals(m, 3);
+    const types::FlowField32 ff{m, goals, 1};
+    checkFlowField(m, ff);
+
+    SECTION("Parallel builds are identical to sequential builds") {
+        for (const auto numThreads: {2u, 3u, 8u}) {
+            const types::FlowField32 pff{m, goals, numThreads};
+            REQUIRE(pff.getDistances() == ff.getDistances());
+            REQUIRE(pff.getDirections() == ff.getDirections());
+        }
+    }
+
+    SECTION("16-bit and 32-bit flow fields agree") {
+        const types::FlowField16 ff16{m, goals, 4};
+        checkFlowField(m, ff16);
+        REQUIRE(ff16.getDirections() == ff.getDirections());
+    }
+}
+
+TEST_CASE("FlowField goals move incrementally", "[maze][flowfield]") {
+    constexpr auto width = 40;
+    constexpr auto height = 30;
+    const maze::DFSMazeGenerator gen{width, height};
+    const auto m = gen.generate().braid(0.3);
+
+    types::FlowField32 ff{m, randomGoals(m, 2), 2};
+    for (auto round = 0; round < 20; ++round) {
+        // Move one goal a little, and occasionally add or drop one.
+        auto goals = ff.getGoals();
+        auto &g = goals[math::RNG::randomRange(static_cast<int>(goals.size()))];
+        g = types::cell(std::clamp(g.first + math::RNG::randomRange(-2, 3), 0, width - 1),
+                        std::clamp(g.second + math::RNG::randomRange(-2, 3), 0, height - 1));
+        if (round % 5 == 1)
+            goals.emplace_back(types::cell(math::RNG::randomRange(width), math::RNG::randomRange(height)));
+        if (round % 5 == 3 && goals.size() > 1)
+            goals.pop_back();
+
+        ff.setGoals(goals);
+        checkFlowField(m, ff);
+
+        const types::FlowField32 fresh{m, goals, 1};
+        REQUIRE(ff.getDirections() == fresh.getDirections());
+    }
+}
+
+TEST_CASE("FlowField over a ThickMaze cave", "[thickmaze][flowfield]") {
+    constexpr auto width = 60;
+    constexpr auto height = 45;
+    thickmaze::CellularAutomatonThickMazeGenerator gen{width, height};
+    const auto tm = gen.generate();
+
+    types::FlowField16 ff{tm, randomGoals(tm, 4), 3};
+    checkFlowField(tm, ff);
+
+    ff.setGoals(randomGoals(tm, 2));
+    checkFlowField(tm, ff);
+    ff.rebuild(1);
+    checkFlowField(tm, ff);
+}
+
+TEST_CASE("FlowField rejects goals outside of the maze", "[maze][flowfield]") {
+    const maze::DFSMazeGenerator gen{10, 10};
+    const auto m = gen.generate();
+    REQUIRE_THROWS_AS(types::FlowField32(m, types::CellCollection{types::cell(10, 0)}), types::OutOfBoundsCoordinates);
+}
@@ -0,0 +1,111 @@
+/**
+ * TestIncrementalPathPlanner.cpp
+ *
+ * By Sebastian Raaphorst, 2018.
+ *
+ * Tests that the IncrementalPathPlanner agrees with BFS as mazes are modified.
+ */
+
+#include <catch.hpp>
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+#include <math/RNG.h>
+#include <types/AbstractMaze.h>
+#include <types/CommonMazeAttributes.h>
+#include <types/Direction.h>
+#include <types/IncrementalPathPlanner.h>
+#include <maze/DFSMazeGenerator.h>
+#include <maze/Maze.h>
+#include <thickmaze/CellularAutomatonThickMazeGenerator.h>
+#include <thickmaze/ThickMaze.h>
+
+using namespace spelunker;
+
+namespace {
+    /// Find the distance between two cells using BFS, or -1 if there is no path.
+    int bfsDistance(const types::AbstractMaze &m, const types::Cell &from, const types::Cell &to) {
+        if (!m.cellInBounds(from))
+            return from == to ? 0 : -1;
+        const auto bfsResults = m.performBFSFrom(from);
+        for (auto d = 0; d < static_cast<int>(bfsResults.distances.size()); ++d) {
+            const auto &cells = bfsResults.distances[d];
+            if (std::find(cells.cbegin(), cells.cend(), to) != cells.cend())
+                return d;
+        }
+        return -1;
+    }
+
+    /// Check that a path is made up of adjacent cells of the maze and has the expected length.
+    void checkPath(const types::AbstractMaze &m, const types::CellCollection &path, int distance) {
+        REQUIRE(static_cast<int>(path.size()) == (distance == -1 ? 0 : distance + 1));
+        for (auto i = 0; i + 1 < static_cast<int>(path.size()); ++i) {
+            const auto nbrs = m.neighbours(path[i]);
+            REQUIRE(std::find(nbrs.cbegin(), nbrs.cend(), path[i + 1]) != nbrs.cend());
+        }
+    }
+}
+
+TEST_CASE("IncrementalPathPlanner repairs paths in a Maze", "[maze][incrementalpathplanner]") {
+    constexpr auto width = 40;
+    constexpr auto height = 30;
+    const maze::DFSMazeGenerator gen{width, height};
+    // Mazes are immutable, so we hold the current version by pointer: the planner refers to it.
+    auto m = std::make_unique<maze::Maze>(gen.generate().braid(0.3));
+
+    const auto goal = types::cell(width - 1, height - 1);
+    auto start = types::cell(0, 0);
+    types::IncrementalPathPlanner planner{*m, start, goal};
+    REQUIRE(planner.computeShortestPath() == bfsDistance(*m, start, goal));
+
+    for (auto round = 0; round < 20; ++round) {
+        // Toggle a batch of random interior walls.
+        std::vector<types::Position> positions;
+        types::CellCollection changed;
+        for (auto i = 0; i < 5; ++i) {
+            const auto c = types::cell(math::RNG::randomRange(width - 1), math::RNG::randomRange(height - 1));
+            positions.emplace_back(types::pos(c, math::RNG::randomElement(
+                    std::vector<types::Direction>{types::Direction::EAST, types::Direction::SOUTH})));
+            changed.emplace_back(c);
+        }
+        auto next = std::make_unique<maze::Maze>(m->toggleWalls(positions));
+        planner.updateMaze(*next, changed);
+        m = std::move(next);
+
+        // Walk partway along the current path.
+        const auto path = planner.shortestPath();
+        checkPath(*m, path, bfsDistance(*m, start, goal));
+        if (path.size() > 3) {
+            start = path[2];
+            planner.moveStart(start);
+        }
+        REQUIRE(planner.computeShortestPath() == bfsDistance(*m, start, goal));
+    }
+}
+
+TEST_CASE("IncrementalPathPlanner repairs paths in a ThickMaze", "[thickmaze][incrementalpathplanner]") {
+    constexpr auto width = 40;
+    constexpr auto height = 30;
+    thickmaze::CellularAutomatonThickMazeGenerator gen{width, height};
+    auto tm = std::make_unique<thickmaze::ThickMaze>(gen.generate());
+
+    const auto start = types::cell(0, 0);
+    const auto goal = types::cell(width - 1, height - 1);
+    types::IncrementalPathPlanner planner{*tm, start, goal};
+    REQUIRE(planner.computeShortestPath() == bfsDistance(*tm, start, goal));
+
+    for (auto round = 0; round < 20; ++round) {
+        types::CellCollection changed;
+        for (auto i = 0; i < 10; ++i)
+            changed.emplace_back(types::cell(math::RNG::randomRange(width), math::RNG::randomRange(height)));
+        auto next = std::make_unique<thickmaze::ThickMaze>(tm->toggleCells(changed));
+        planner.updateMaze(*next, changed);
+        tm = std::move(next);
+
+        const auto distance = bfsDistance(*tm, start, goal);
+        REQUIRE(planner.computeShortestPath() == distance);
+        checkPath(*tm, planner.shortestPath(), distance);
+    }
+}
@@ -0,0 +1,92 @@
+/**
+ * TestMazeStepper.cpp
+ *
+ * By Sebastian Raaphorst, 2018.
+ *
+ * Tests that generations advanced in steps produce the same mazes as generating them all at once.
+ */
+
+#include <catch.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+
+#include <math/DefaultRNG.h>
+#include <math/RNG.h>
+#include <maze/DFSMazeGenerator.h>
+#include <maze/KruskalMazeGenerator.h>
+#include <maze/Maze.h>
+#include <maze/MazeGenerator.h>
+#include <maze/PrimMazeGenerator.h>
+#include <maze/WilsonMazeGenerator.h>
+#include <thickmaze/CellularAutomatonThickMazeGenerator.h>
+#include <thickmaze/ThickMaze.h>
+#include <thickmaze/ThickMazeGenerator.h>
+
+using namespace spelunker;
+
+namespace {
+    /// Check that a generator's stepper, advanced a few steps at a time, gives the same maze as generate.
+    template<typename G, typename T>
+    void checkStepper(const G &gen) {
+        constexpr std::uint64_t seed = 2018;
+        const auto expected = [&gen, seed] {
+            const math::RNG::ThreadRNGScope scope{std::make_shared<math::DefaultRNG>(seed)};
+            return gen.generate();
+        }();
+
+        const math::RNG::ThreadRNGScope scope{std::make_shared<math::DefaultRNG>(seed)};
+        const auto stepper = gen.stepper();
+        auto numAdvances = 0;
+        while (!stepper->advance(7)) {
+            REQUIRE(stepper->getNumSteps() == 7u * ++numAdvances);
+            const T partial = stepper->current();
+            REQUIRE(partial.getDimensions() == gen.getDimensions());
+        }
+        REQUIRE(stepper->isDone());
+        REQUIRE(stepper->current() == expected);
+
+        // Once done, there is nothing left to do.
+        const auto numSteps = stepper->getNumSteps();
+        REQUIRE(stepper->advance(1));
+        REQUIRE(stepper->getNumSteps() == numSteps);
+    }
+}
+
+TEST_CASE("Maze steppers produce the same mazes as generate", "[types][stepper]") {
+    constexpr auto width = 23;
+    constexpr auto height = 17;
+    checkStepper<maze::DFSMazeGenerator, maze::Maze>(maze::DFSMazeGenerator{width, height});
+    checkStepper<maze::KruskalMazeGenerator, maze::Maze>(maze::KruskalMazeGenerator{width, height});
+    checkStepper<maze::PrimMazeGenerator, maze::Maze>(maze::PrimMazeGenerator{width, height});
+    checkStepper<maze::WilsonMazeGenerator, maze::Maze>(maze::WilsonMazeGenerator{width, height});
+}
+
+TEST_CASE("Thick maze steppers produce the same mazes as generate", "[types][stepper]") {
+    using Generator = thickmaze::CellularAutomatonThickMazeGenerator;
+    Generator::settings st;
+    st.neighbourhoodType = Generator::VON_NEUMANN_EXTENDED;
+    st.rule = Generator::fromAlgorithm(Generator::MAZECTRIC);
+    checkStepper<Generator, thickmaze::ThickMaze>(Generator{31, 19});
+    checkStepper<Generator, thickmaze::ThickMaze>(Generator{31, 19, st});
+}
+
+TEST_CASE("Maze steppers show the passages carved so far", "[types][stepper]") {
+    const auto stepper = maze::DFSMazeGenerator{20, 20}.stepper();
+    REQUIRE(stepper->current().numCarvedWalls() == 0);
+    stepper->advance(10);
+    REQUIRE(stepper->current().numCarvedWalls() == 10);
+}
+
+TEST_CASE("Maze steppers respect a time budget", "[types][stepper]") {
+    const auto stepper = maze::WilsonMazeGenerator{200, 200}.stepper();
+    REQUIRE(!stepper->advance(std::chrono::microseconds{0}));
+    REQUIRE(stepper->getNumSteps() == 0);
+
+    stepper->advance(std::chrono::milliseconds{1});
+    REQUIRE(stepper->getNumSteps() > 0);
+
+    while (!stepper->advance(std::chrono::milliseconds{5}));
+    REQUIRE(stepper->current().numCarvedWalls() == 200 * 200 - 1);
+}
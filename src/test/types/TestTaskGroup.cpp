@@ -0,0 +1,42 @@
+/**
+ * TestTaskGroup.cpp
+ *
+ * By Sebastian Raaphorst, 2018.
+ *
+ * Tests that a TaskGroup runs every task, including the tasks run by other tasks.
+ */
+
+#include <catch.hpp>
+
+#include <atomic>
+#include <functional>
+
+#include <types/Parallel.h>
+
+using namespace spelunker;
+
+TEST_CASE("TaskGroup runs nested tasks", "[types][parallel]") {
+    for (const auto numThreads: {1u, 2u, 8u}) {
+        std::atomic<int> numLeaves{0};
+        types::TaskGroup tasks{numThreads};
+
+        // Split the range [0, 1000) recursively, counting the leaves.
+        std::function<void(int, int)> split = [&](const int begin, const int end) {
+            if (end - begin == 1) {
+                ++numLeaves;
+                return;
+            }
+            const auto mid = (begin + end) / 2;
+            tasks.run([&split, mid, end] { split(mid, end); });
+            split(begin, mid);
+        };
+        split(0, 1000);
+        tasks.wait();
+        REQUIRE(numLeaves == 1000);
+
+        // The group can be reused after waiting.
+        tasks.run([&numLeaves] { ++numLeaves; });
+        tasks.wait();
+        REQUIRE(numLeaves == 1001);
+    }
+}
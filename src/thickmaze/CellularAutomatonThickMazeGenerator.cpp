@@ -4,11 +4,21 @@
  * By Sebastian Raaphorst, 2018.
  */
 
-#include <list>
-
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <memory>
+#include <numeric>
+#include <stdexcept>
+#include <vector>
+
+#include <types/BitUtils.h>
 #include <types/CommonMazeAttributes.h>
 #include <types/Dimensions2D.h>
-#include <math/RNG.h>
+#include <types/Exceptions.h>
+#include <types/Parallel.h>
+#include <math/CounterRNG.h>
 
 #include "ThickMaze.h"
 #include "ThickMazeAttributes.h"
@@ -16,125 +26,179 @@
 #include "CellularAutomatonThickMazeGenerator.h"
 
 namespace spelunker::thickmaze {
-    static int wrap(int max, int x) {
-        if (x < 0) return max + x + 1;
-        if (x > max) return x % (max + 1);
-        else return x;
+    namespace {
+        using Word = std::uint64_t;
 
-    }
-    static int moore(const types::Cell c, const CellContents &cs) {
-        int alive = 0;
-        const auto maxRow = cs[0].size() - 1;
-        const auto maxCol = cs.size() - 1;
-
-        auto[x, y] = c;
-        const auto xm1 = wrap(maxCol, x-1);
-        const auto xp1 = wrap(maxCol, x+1);
-        const auto ym1 = wrap(maxRow, y-1);
-        const auto yp1 = wrap(maxRow, y+1);
-
-        // Covers the entire west column. Assume toroidal structure.
-        if (cs[xm1][ym1] == CellType::WALL) ++alive;
-        if (cs[xm1][y]   == CellType::WALL) ++alive;
-        if (cs[xm1][yp1] == CellType::WALL) ++alive;
-
-        // Covers the entire east column. Assume toroidal structure.
-        if (cs[xp1][ym1] == CellType::WALL) ++alive;
-        if (cs[xp1][y]   == CellType::WALL) ++alive;
-        if (cs[xp1][yp1] == CellType::WALL) ++alive;
-
-        // Cover the north and south cells.
-        if (cs[x][ym1]   == CellType::WALL) ++alive;
-        if (cs[x][yp1]   == CellType::WALL) ++alive;
-
-        return alive;
-    }
+        /// The fewest words of the grid worth handing to a thread of their own.
+        constexpr int minWordsPerThread = 4096;
 
-    static int vonNeumann(const types::Cell c, const CellContents &cs) {
-        int alive = 0;
-        const auto maxRow = cs[0].size() - 1;
-        const auto maxCol = cs.size() - 1;
-
-        auto[x, y] = c;
-        const auto xm1 = wrap(maxCol, x-1);
-        const auto xm2 = wrap(maxCol, x-2);
-        const auto xp1 = wrap(maxCol, x+1);
-        const auto xp2 = wrap(maxCol, x+2);
-        const auto ym1 = wrap(maxRow, y-1);
-        const auto ym2 = wrap(maxRow, y-2);
-        const auto yp1 = wrap(maxRow, y+1);
-        const auto yp2 = wrap(maxRow, y+2);
-
-        // West segment.
-        if (cs[xm2][y] == CellType::WALL) ++alive;
-        if (cs[xm1][y] == CellType::WALL) ++alive;
-
-        // East segment
-        if (cs[xp1][y] == CellType::WALL) ++alive;
-        if (cs[xp2][y] == CellType::WALL) ++alive;
-
-        // North segment
-        if (cs[x][ym1] == CellType::WALL) ++alive;
-        if (cs[x][ym2] == CellType::WALL) ++alive;
-
-        // South segment
-        if (cs[x][yp1] == CellType::WALL) ++alive;
-        if (cs[x][yp2] == CellType::WALL) ++alive;
-
-        return alive;
-    }
+        /// The mask of the cells of the last word of a row.
+        inline Word lastWordMask(const int width) noexcept {
+            const auto used = width % types::WordBits;
+            return used == 0 ? ~Word{0} : (Word{1} << static_cast<unsigned int>(used)) - 1;
+        }
+
+        inline int wrap(const int max, const int x) noexcept {
+            return ((x % max) + max) % max;
+        }
+
+        /**
+         * Rotate a row of cells so that cell x of the result is cell (x + offset) mod width of the original.
+         * The words are shifted wholesale, and then the few cells that wrap around are fixed individually.
+         */
+        void rotateRow(const Word *src, Word *dst, const int width, const int rowWords, const int offset) noexcept {
+            if (offset > 0) {
+                const auto k = static_cast<unsigned int>(offset);
+                for (auto w = 0; w < rowWords; ++w)
+                    dst[w] = (src[w] >> k) | (w + 1 < rowWords ? src[w + 1] << (types::WordBits - k) : 0);
+                for (auto x = std::max(0, width - offset); x < width; ++x) {
+                    types::clearBit(dst, x);
+                    if (types::testBit(src, wrap(width, x + offset)))
+                        types::setBit(dst, x);
+                }
+            } else {
+                const auto k = static_cast<unsigned int>(-offset);
+                for (auto w = 0; w < rowWords; ++w)
+                    dst[w] = (src[w] << k) | (w > 0 ? src[w - 1] >> (types::WordBits - k) : 0);
+                for (auto x = 0; x < std::min(-offset, width); ++x) {
+                    types::clearBit(dst, x);
+                    if (types::testBit(src, wrap(width, x + offset)))
+                        types::setBit(dst, x);
+                }
+            }
+            dst[rowWords - 1] &= lastWordMask(width);
+        }
+
+        /// Hash a row of cells, so that the hash of a grid is the sum of those of its rows.
+        inline Word rowHash(const Word *r, const int y, const int rowWords) noexcept {
+            auto hash = math::mix64(static_cast<Word>(y) + 0x9e3779b97f4a7c15ull);
+            for (auto w = 0; w < rowWords; ++w)
+                hash = math::mix64(hash ^ r[w]);
+            return hash;
+        }
 
-    CellularAutomatonThickMazeGenerator::NeighbourCounter CellularAutomatonThickMazeGenerator::fromNeighbourhoodType(NeighbourhoodType n) {
-        switch (n) {
-            case MOORE:
-                return &moore;
-            case VON_NEUMANN_EXTENDED:
-                return &vonNeumann;
+        inline void fullAdder(const Word a, const Word b, const Word c, Word &sum, Word &carry) noexcept {
+            const auto ab = a ^ b;
+            sum = ab ^ c;
+            carry = (a & b) | (c & ab);
+        }
+
+        inline void halfAdder(const Word a, const Word b, Word &sum, Word &carry) noexcept {
+            sum = a ^ b;
+            carry = a & b;
+        }
+
+        /**
+         * A rule compiled into a table for @see{evolveRow} once per generation run: the counts of neighbours for which a
+         * cell may be a wall in the next generation, each with masks selecting whether floor cells with that count are
+         * born, wall cells with it survive, or both, so that words of cells are combined without testing the rule.
+         */
+        struct CompiledRule {
+            int numCounts = 0;
+            int counts[9];
+            Word bornMasks[9];
+            Word surviveMasks[9];
+        };
+
+        CompiledRule compileRule(const CellularAutomatonThickMazeGenerator::Rule &rule) noexcept {
+            CompiledRule compiled;
+            for (auto n = 0; n <= 8; ++n) {
+                const auto bit = 1u << static_cast<unsigned int>(n);
+                if (!((rule.born | rule.survive) & bit))
+                    continue;
+                compiled.counts[compiled.numCounts] = n;
+                compiled.bornMasks[compiled.numCounts] = (rule.born & bit) ? ~Word{0} : 0;
+                compiled.surviveMasks[compiled.numCounts] = (rule.survive & bit) ? ~Word{0} : 0;
+                ++compiled.numCounts;
+            }
+            return compiled;
+        }
+
+        /**
+         * Compute a row of the next generation from the eight rows of neighbours of its cells, 64 cells at a time.
+         * The neighbours are added into the bit planes of the four bit counts, from which the words of cells having
+         * each count in the rule are selected and combined.
+         */
+        void evolveRow(const Word *const (&nbrs)[8], const Word *old, Word *out, const int rowWords,
+                       const Word lastMask, const CompiledRule &rule) noexcept {
+            for (auto w = 0; w < rowWords; ++w) {
+                // Add the eight neighbours: first in threes into units and twos...
+                Word sa, ca, sb, cb, sc, cc;
+                fullAdder(nbrs[0][w], nbrs[1][w], nbrs[2][w], sa, ca);
+                fullAdder(nbrs[3][w], nbrs[4][w], nbrs[5][w], sb, cb);
+                halfAdder(nbrs[6][w], nbrs[7][w], sc, cc);
+
+                // ... and then the units into the ones bit, and the twos into the twos and fours bits.
+                Word s0, cd, se, ce, s1, cf, s2, s3;
+                fullAdder(sa, sb, sc, s0, cd);
+                fullAdder(ca, cb, cc, se, ce);
+                halfAdder(se, cd, s1, cf);
+                halfAdder(ce, cf, s2, s3);
+
+                // The cells whose counts have each value of the low two bits and of the high bits. A count of 8 has only
+                // s3 set, so its low bits are 0.
+                const Word lo[4] = {~s1 & ~s0, ~s1 & s0, s1 & ~s0, s1 & s0};
+                const Word hi[3] = {~s3 & ~s2, ~s3 & s2, s3};
+
+                Word born = 0;
+                Word survive = 0;
+                for (auto i = 0; i < rule.numCounts; ++i) {
+                    const auto n = rule.counts[i];
+                    const auto count = hi[n >> 2] & lo[n & 3];
+                    born |= count & rule.bornMasks[i];
+                    survive |= count & rule.surviveMasks[i];
+                }
+
+                out[w] = (old[w] & survive) | (~old[w] & born);
+            }
+            out[rowWords - 1] &= lastMask;
         }
     }
 
+    CellularAutomatonThickMazeGenerator::Rule CellularAutomatonThickMazeGenerator::fromAlgorithm(Algorithm a) {
+        // Masks with bit n set for each count n in the rule.
+        const auto counts = [](std::initializer_list<int> ns) {
+            std::uint16_t mask = 0;
+            for (const auto n: ns)
+                mask |= 1u << static_cast<unsigned int>(n);
+            return mask;
+        };
 
-    CellularAutomatonThickMazeGenerator::DetermineBehaviour CellularAutomatonThickMazeGenerator::fromAlgorithm(Algorithm a) {
         switch (a) {
             case MAZECTRIC:
                 // B3/S1234
-                return [](const int num, const CellType ct) {
-                    if (num >= 1 && num <= 4 && ct == CellType::WALL) return SURVIVE;
-                    if (num == 3 && ct == CellType::FLOOR) return BORN;
-                    return DIE;
-                };
+                return Rule{counts({3}), counts({1, 2, 3, 4})};
             case MAZE:
                 // B3/S12345
-                return [](const int num, const CellType ct) {
-                    if (num >= 1 && num <= 5 && ct == CellType::WALL) return SURVIVE;
-                    if (num == 3 && ct == CellType::FLOOR) return BORN;
-                    return DIE;
-                };
+                return Rule{counts({3}), counts({1, 2, 3, 4, 5})};
             case VOTE45:
                 // B4678/S35678: This algorithm seems flawed, as it fills up.
                 // Recommended on: https://steamcommunity.com/app/357330/discussions/0/618459405722195374
-                return [](const int num, const CellType ct) {
-                    if ((num == 3 || (num >=5 && num <=8)) && ct == CellType::WALL) return SURVIVE;
-                    if ((num == 4 || (num >= 6 && num <= 8)) && ct == CellType::FLOOR) return BORN;
-                    return DIE;
-                };
+                return Rule{counts({4, 6, 7, 8}), counts({3, 5, 6, 7, 8})};
             case VOTE:
                 // B5678/S45678: This algorithm produces cavernous rooms.
                 // Recommended on: https://steamcommunity.com/app/357330/discussions/0/618459405722195374
-                return [](const int num, const CellType ct) {
-                    if (num >= 4 && num <= 8 && ct == CellType::WALL) return SURVIVE;
-                    if (num >= 5 && num <= 8 && ct == CellType::FLOOR) return BORN;
-                    return DIE;
-                };
+                return Rule{counts({5, 6, 7, 8}), counts({4, 5, 6, 7, 8})};
             case B2S123:
                 // B2/S123
                 // Recommended on: https://english.rejbrand.se/rejbrand/article.asp?ItemIndex=421
-                return [](const int num, const CellType ct) {
-                    if (num >= 1 && num <= 3 && ct == CellType::WALL) return SURVIVE;
-                    if (num == 2 && ct == CellType::FLOOR) return BORN;
-                    return DIE;
-                };
+                return Rule{counts({2}), counts({1, 2, 3})};
+        }
+        throw std::invalid_argument("Unknown cellular automaton algorithm.");
+    }
+
+    CellularAutomatonThickMazeGenerator::Rule
+    CellularAutomatonThickMazeGenerator::fromBehaviour(const DetermineBehaviour &determineBehaviour) {
+        // A floor cell becomes a wall only if born, and a wall stays a wall if it survives or is born again.
+        Rule rule{0, 0};
+        for (auto n = 0; n <= 8; ++n) {
+            const auto bit = 1u << static_cast<unsigned int>(n);
+            if (determineBehaviour(n, CellType::FLOOR) == BORN)
+                rule.born |= bit;
+            if (determineBehaviour(n, CellType::WALL) != DIE)
+                rule.survive |= bit;
         }
+        return rule;
     }
 
     CellularAutomatonThickMazeGenerator::CellularAutomatonThickMazeGenerator(const types::Dimensions2D &d, const settings &s)
@@ -149,57 +213,201 @@ namespace spelunker::thickmaze {
     CellularAutomatonThickMazeGenerator::CellularAutomatonThickMazeGenerator(int w, int h)
         : CellularAutomatonThickMazeGenerator{types::Dimensions2D{w, h}, settings{}} {}
 
-    const ThickMaze CellularAutomatonThickMazeGenerator::generate() const noexcept {
-        const auto [width, height] = getDimensions().values();
+    class CellularAutomatonThickMazeGenerator::Stepper final : public ThickMazeStepper {
+    public:
+        /// Begin from the given grid if there is one, and otherwise from a random one.
+        Stepper(const CellularAutomatonThickMazeGenerator &g, const ThickMaze *initial)
+            : ThickMazeStepper{g.getDimensions()},
+              st{g.st},
+              rule{compileRule(g.st.rule)},
+              width{g.getWidth()},
+              height{g.getHeight()},
+              rowWords{types::numWords(g.getWidth())},
+              grid(static_cast<std::size_t>(rowWords) * g.getHeight(), 0),
+              nextGrid(grid.size(), 0),
+              rowHashes(g.getHeight(), 0) {
+            if (initial) {
+                for (auto y = 0; y < height; ++y) {
+                    const auto r = rowOf(grid, y);
+                    for (auto x = 0; x < width; ++x)
+                        if (initial->cellIs(x, y) == CellType::WALL)
+                            types::setBit(r, x);
+                    rowHashes[y] = rowHash(r, y, rowWords);
+                }
+            } else {
+                // Create the random initialization, 64 cells at a time, with a stream for each row.
+                const auto rng = math::CounterRNG::fromRNG();
+                const auto lastMask = lastWordMask(width);
+                types::parallelFor(0, width > 0 ? height : 0, numThreadsFor(height), [&](int, int begin, int end) {
+                    for (auto y = begin; y < end; ++y) {
+                        const auto r = rowOf(grid, y);
+                        for (auto w = 0; w < rowWords; ++w)
+                            r[w] = rng.bernoulliWord(static_cast<std::uint64_t>(y), static_cast<std::uint64_t>(w),
+                                                     st.probability);
+                        r[rowWords - 1] &= lastMask;
+                        rowHashes[y] = rowHash(r, y, rowWords);
+                    }
+                });
+            }
+            tortoise = grid;
+            tortoiseHash = gridHash();
 
-        // Create and initialize the cell contents.
-        auto contents = createThickMazeLayout(getDimensions());
+            done = st.numGenerations <= 0 || width == 0 || height == 0;
+        }
 
-        // The back-check chart.
-        std::list<CellContents> prevs;
+        bool isDone() const noexcept final {
+            return done;
+        }
 
-        // Create the random initialization.
-        for (auto y = 0; y < height; ++y)
-            for (auto x = 0; x < width; ++x)
-                if (math::RNG::randomProbability() < st.probability)
-                    contents[x][y] = CellType::WALL;
-        prevs.emplace_back(contents);
+        /// The most recent complete generation.
+        const ThickMaze current() const final {
+            auto contents = createThickMazeLayout(width, height);
+            for (auto y = 0; y < height; ++y)
+                for (auto x = 0; x < width; ++x)
+                    if (types::testBit(rowOf(grid, y), x))
+                        contents[x][y] = CellType::WALL;
+            return ThickMaze(getDimensions(), contents);
+        }
 
-        // Run the algorithm for the desired number of iterations unless stability is first achieved.
-        auto inconsistent = true;
+    protected:
+        std::uint64_t run(const std::uint64_t maxSteps) final {
+            std::uint64_t steps = 0;
+            while (steps < maxSteps && !done) {
+                // Compute as many rows of the next generation as we may, in stripes, but only use as many threads as
+                // the work can keep busy.
+                const auto numRows = static_cast<int>(std::min<std::uint64_t>(maxSteps - steps, height - row));
+                types::parallelFor(row, row + numRows, numThreadsFor(numRows), [this](int, int begin, int end) {
+                    evolveRows(begin, end);
+                });
+                steps += numRows;
+                row += numRows;
+                if (row < height)
+                    continue;
+
+                // The generation is complete. By Brent's algorithm, stop if it repeats the tortoise, which is compared
+                // in full only if the hashes match, and otherwise move the tortoise up each time the distance between
+                // them reaches a power of two, so that a cycle of any length is found.
+                std::swap(grid, nextGrid);
+                row = 0;
+                ++generation;
+
+                const auto hash = gridHash();
+                if (hash == tortoiseHash && grid == tortoise) {
+                    done = true;
+                    break;
+                }
+                if (distance == power) {
+                    tortoise = grid;
+                    tortoiseHash = hash;
+                    power *= 2;
+                    distance = 0;
+                }
+                ++distance;
 
-        for (auto i = 0; i < st.numGenerations && inconsistent; ++i) {
-            // Create a new contents to initialize.
-            auto newContents = createThickMazeLayout(width, height);
+                if (generation >= st.numGenerations)
+                    done = true;
+            }
+            return steps;
+        }
 
-            // Get the old contents from which to work.
-            const auto &oldContents = prevs.back();
+    private:
+        /// The number of threads worth using for the given number of rows.
+        inline unsigned int numThreadsFor(const int numRows) const noexcept {
+            return std::min(st.numThreads == 0 ? types::defaultNumThreads() : st.numThreads,
+                            static_cast<unsigned int>(std::max(1, numRows * rowWords / minWordsPerThread)));
+        }
 
-            // Iterate over each cell and determine its state.
-            for (auto y = 0; y < height; ++y)
-                for (auto x = 0; x < width; ++x) {
-                    // Count the neighbours for this cell.
-                    int numNbrs = st.neighbourCounter(types::cell(x, y), oldContents);
-
-                    // Determine the behaviour of this cell.
-                    // As newContents was initialized to all floor, we can ignore death.
-                    Behaviour b = st.determineBehaviour(numNbrs, oldContents[x][y]);
-                    if (b == SURVIVE) newContents[x][y] = oldContents[x][y];
-                    else if (b == BORN) newContents[x][y] = CellType::WALL;
-                }
+        inline Word *rowOf(std::vector<Word> &g, const int y) const noexcept {
+            return g.data() + static_cast<std::size_t>(y) * rowWords;
+        }
 
-            for (auto &prev : prevs) {
-                if (newContents == prev) {
-                    inconsistent = false;
-                    break;
+        inline const Word *rowOf(const std::vector<Word> &g, const int y) const noexcept {
+            return g.data() + static_cast<std::size_t>(y) * rowWords;
+        }
+
+        inline Word gridHash() const noexcept {
+            return std::accumulate(rowHashes.cbegin(), rowHashes.cend(), Word{0});
+        }
+
+        /// Compute the rows [begin, end) of the next generation, and their hashes.
+        void evolveRows(const int begin, const int end) {
+            const auto lastMask = lastWordMask(width);
+
+            // Scratch rows for the rotated copies of the rows around each row.
+            std::vector<Word> scratch(static_cast<std::size_t>(rowWords) * 6);
+            const auto scratchRow = [&scratch, this](const int i) { return scratch.data() + i * rowWords; };
+
+            for (auto y = begin; y < end; ++y) {
+                const Word *nbrs[8];
+                if (st.neighbourhoodType == MOORE) {
+                    // The three cells above, the two beside, and the three below.
+                    for (auto dy = -1, i = 0; dy <= 1; ++dy) {
+                        const auto src = rowOf(grid, wrap(height, y + dy));
+                        rotateRow(src, scratchRow(2 * (dy + 1)), width, rowWords, -1);
+                        rotateRow(src, scratchRow(2 * (dy + 1) + 1), width, rowWords, 1);
+                        nbrs[i++] = scratchRow(2 * (dy + 1));
+                        nbrs[i++] = scratchRow(2 * (dy + 1) + 1);
+                        if (dy != 0)
+                            nbrs[i++] = src;
+                    }
+                } else {
+                    // The two cells in each direction.
+                    const auto src = rowOf(grid, y);
+                    for (auto d = 1, i = 0; d <= 2; ++d) {
+                        rotateRow(src, scratchRow(i), width, rowWords, -d);
+                        nbrs[i] = scratchRow(i);
+                        ++i;
+                        rotateRow(src, scratchRow(i), width, rowWords, d);
+                        nbrs[i] = scratchRow(i);
+                        ++i;
+                    }
+                    nbrs[4] = rowOf(grid, wrap(height, y - 2));
+                    nbrs[5] = rowOf(grid, wrap(height, y - 1));
+                    nbrs[6] = rowOf(grid, wrap(height, y + 1));
+                    nbrs[7] = rowOf(grid, wrap(height, y + 2));
                 }
+                evolveRow(nbrs, rowOf(grid, y), rowOf(nextGrid, y), rowWords, lastMask, rule);
+                rowHashes[y] = rowHash(rowOf(nextGrid, y), y, rowWords);
             }
-            contents = newContents;
-            prevs.emplace_back(newContents);
-            while (prevs.size() > st.stabilitySize)
-                prevs.pop_front();
         }
 
-        return ThickMaze(getDimensions(), contents);
+        const settings st;
+        const CompiledRule rule;
+        const int width;
+        const int height;
+        const int rowWords;
+
+        // The current generation, and the next generation, computed up to the given row, with the hashes of the rows
+        // of the latter as they are computed.
+        std::vector<Word> grid;
+        std::vector<Word> nextGrid;
+        std::vector<Word> rowHashes;
+        int row = 0;
+
+        // The generation against which the later ones are compared to detect a cycle, how many generations it is
+        // behind the current one, and the number of generations after which it moves up.
+        std::vector<Word> tortoise;
+        Word tortoiseHash;
+        std::uint64_t distance = 1;
+        std::uint64_t power = 1;
+
+        int generation = 0;
+        bool done;
+    };
+
+    const ThickMaze CellularAutomatonThickMazeGenerator::generate() const noexcept {
+        Stepper stepper{*this, nullptr};
+        stepper.finish();
+        return stepper.current();
+    }
+
+    std::unique_ptr<ThickMazeStepper> CellularAutomatonThickMazeGenerator::stepper() const {
+        return std::make_unique<Stepper>(*this, nullptr);
+    }
+
+    std::unique_ptr<ThickMazeStepper> CellularAutomatonThickMazeGenerator::stepper(const ThickMaze &initial) const {
+        if (initial.getDimensions() != getDimensions())
+            throw types::IllegalDimensions(initial.getWidth(), initial.getHeight());
+        return std::make_unique<Stepper>(*this, &initial);
     }
 }
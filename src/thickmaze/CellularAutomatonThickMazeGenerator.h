@@ -4,7 +4,7 @@
  * By Sebastian Raaphorst, 2018.
  *
  * A 2D cellular automaton with specified birth and survival patterns with a given
- * neighbourhood type.
+ * neighbourhood type, simulated 64 cells at a time on bit-packed rows.
  *
  * There is some interesting information here:
  * https://english.rejbrand.se/rejbrand/article.asp?ItemIndex=421
@@ -12,7 +12,9 @@
 
 #pragma once
 
+#include <cstdint>
 #include <functional>
+#include <memory>
 
 #include <types/CommonMazeAttributes.h>
 #include <types/Dimensions2D.h>
@@ -37,31 +39,32 @@ namespace spelunker::thickmaze {
      * seeds for other algorithm.
      *
      * They tend to achieve stability very quickly, i.e. either reach a constant state that does not
-     * change, or alternate between a small number of states.
+     * change, or alternate between a small number of states. We terminate once a generation repeats, which is
+     * detected with Brent's cycle detection algorithm, so that cycles of any length are found while keeping only one
+     * earlier generation, compared against in full only when the hashes of the generations match.
      *
      * Note that these algorithms sometimes do better if the resultant mazes are reversed via a call
      * to @see{ThickMaze#reverse}.
+     *
+     * The grid is stored with each row packed into 64-bit words, a set bit being a wall. A generation finds the eight
+     * neighbours of 64 cells at once as rotated copies of the nearby rows, adds them with bitwise full adders into
+     * four bit planes of the counts, and applies the masks of the @see{Rule} to those planes. Generations alternate
+     * between two grids, and the rows of each are divided into stripes computed by separate threads.
      */
     class CellularAutomatonThickMazeGenerator final : public ThickMazeGenerator {
     public:
-        /// A function type that determines the number of living neighbours.
-        using NeighbourCounter = std::function<int(const types::Cell, const CellContents&)>;
-
         /// The type of neighbourhood to use for the cellular automaton.
         /**
          * Predetermined types of neighbourhoods to consider in the cellular automaton.
          * The Moore neighbourhood comprises the eight cells directly around a cell.
          * The von Neumann neighbourhood comprises the eight cells of the orthogonal cross of length 2 around a cell.
+         * In both cases, the grid wraps around as a torus.
          */
         enum NeighbourhoodType {
             MOORE,
             VON_NEUMANN_EXTENDED,
         };
 
-        /// A function type that determines the Behaviour of a cell given the number of living neighbours in its neighbourhood.
-        /// Convert one of the NeighbourhoodTypes into a NeighbourCounter.
-        static NeighbourCounter fromNeighbourhoodType(NeighbourhoodType n);
-
         /// Possible outcomes for a cell at each round depending on the neighbours in its neighbourhood.
         enum Behaviour {
             BORN,
@@ -69,8 +72,19 @@ namespace spelunker::thickmaze {
             DIE,
         };
 
+        /// A function type that determines the Behaviour of a cell given the number of living neighbours in its neighbourhood.
         using DetermineBehaviour = std::function<Behaviour(const int, const CellType)>;
 
+        /// A rule for the automaton, as masks indexed by the number of living neighbours, from 0 to 8.
+        /**
+         * A rule for the automaton: bit n of born is set if a floor cell with n living neighbours becomes a wall, and
+         * bit n of survive is set if a wall with n living neighbours stays a wall. Every other cell becomes floor.
+         */
+        struct Rule {
+            std::uint16_t born;
+            std::uint16_t survive;
+        };
+
         /**
          * Pre-existing algorithms determining behaviour of a cell.
          * They are to be interpreted as:
@@ -94,8 +108,17 @@ namespace spelunker::thickmaze {
             B2S123,
         };
 
-        /// Convert one of the Algorithms into a DetermineBehaviour.
-        static DetermineBehaviour fromAlgorithm(Algorithm a);
+        /// Convert one of the Algorithms into a Rule.
+        /**
+         * Convert one of the Algorithms into a Rule.
+         * @param a the algorithm
+         * @return the rule of the algorithm
+         * @throws invalid_argument if a is not one of the Algorithms
+         */
+        static Rule fromAlgorithm(Algorithm a);
+
+        /// Compile a DetermineBehaviour into a Rule by evaluating it for every number of neighbours and cell type.
+        static Rule fromBehaviour(const DetermineBehaviour &determineBehaviour);
 
         /**
          * Cellular automata have lots of settings, so instead of providing a vast number of constructors, our
@@ -107,28 +130,23 @@ namespace spelunker::thickmaze {
          * numGenerations indicates the maximum number of generations after random seeding that the automaton should
          *    produce. The default value is 10000. This will seldom be achieved.
          *
-         *  stabilitySize is the number of previous generations we store in memory to which co compare the current
-         *     generation. If the current generation is equivalent to one of the stored generations, we terminate.
-         *     The default value is 5.
-         *
-         * neighbourhoodCounter determines how to count the surrounding neighbours of a cell.
-         *    The default is using the Moore neighbourhood.
-         *
-         * determineBehaviour determines the behaviour of each cell with regards to the previous generation.
-         *    The default is B2S123.
+         * neighbourhoodType determines which surrounding cells of a cell are counted as its neighbours.
+         *    The default is the Moore neighbourhood.
          *
-         * The neighbourhoodCounter setting can be manually configured or configured from one of the NeighbourhoodType
-         * values, MOORE or VON_NEUMANN_EXTENDED, by using the static fromNeighbourhoodType algorithm.
+         * rule determines the behaviour of each cell with regards to the previous generation.
+         *    The default is B2S123. It can be configured from one of the Algorithm values, MAZECTRIC, MAZE, VOTE45,
+         *    VOTE, or B2S123 by using the static fromAlgorithm method, or from an arbitrary DetermineBehaviour by
+         *    using the static fromBehaviour method.
          *
-         * The determineBehaviour setting can be manually configured or configured from one of the Algorithm values,
-         * MAZECETRIC, MAZE, VOTE45, VOTE, or B2S123 by using the static fromAlgorithm method.
+         * numThreads is the maximum number of threads over whose stripes of rows each generation is divided, 0 meaning
+         *    one per hardware thread. Small grids use fewer threads, as the work would not pay for starting them.
          */
         struct settings {
             double probability = 0.5;
             int numGenerations = 10000;
-            int stabilitySize = 10;
-            NeighbourCounter neighbourCounter = fromNeighbourhoodType(MOORE);
-            DetermineBehaviour determineBehaviour = fromAlgorithm(B2S123);
+            NeighbourhoodType neighbourhoodType = MOORE;
+            Rule rule = fromAlgorithm(B2S123);
+            unsigned int numThreads = 0;
         };
 
         CellularAutomatonThickMazeGenerator(const types::Dimensions2D &d, const settings &s);
@@ -138,7 +156,24 @@ namespace spelunker::thickmaze {
         ~CellularAutomatonThickMazeGenerator() final = default;
 
         const ThickMaze generate() const noexcept final;
+
+        /**
+         * Begin a generation that can be advanced a bounded number of steps at a time, which produces the same
+         * mazes as @see{generate}. A step is the computation of a row of the next generation.
+         */
+        std::unique_ptr<ThickMazeStepper> stepper() const;
+
+        /**
+         * Begin a generation from the given grid instead of a random one, e.g. to evolve a maze further or to start
+         * from a known pattern.
+         * @param initial the first generation, whose walls are the living cells
+         * @throws IllegalDimensions if the grid does not have the dimensions of the generator
+         */
+        std::unique_ptr<ThickMazeStepper> stepper(const ThickMaze &initial) const;
+
     private:
+        class Stepper;
+
         /// The settings for the cellular automaton.
         settings st;
     };
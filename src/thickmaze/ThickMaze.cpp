@@ -217,6 +217,16 @@ namespace spelunker::thickmaze {
         return ThickMaze(getDimensions(), newContents);
     }
 
+    const ThickMaze ThickMaze::toggleCells(const types::CellCollection &cells) const {
+        auto newContents = contents;
+        for (const auto &c: cells) {
+            checkCell(c);
+            const auto [x, y] = c;
+            newContents[x][y] = newContents[x][y] == CellType::WALL ? CellType::FLOOR : CellType::WALL;
+        }
+        return ThickMaze(getDimensions(), getStartingCell(), getGoalCells(), newContents);
+    }
+
     int ThickMaze::numCellWallsInContents(const types::Cell &c, const CellContents &cc) const {
         checkCell(c);
         const auto [x,y] = c;
@@ -132,6 +132,17 @@ namespace spelunker::thickmaze {
          */
         const ThickMaze braid(double probability) const noexcept override;
 
+        /// Toggle a collection of cells, carving those that are walls and filling those that are floors.
+        /**
+         * This performs the same operation that {@see braid} performs on a single wall cell, for runtime changes to
+         * a maze like opening doors. Toggling the same cell twice restores it.
+         * @param cells the cells to toggle
+         * @return a new maze with the cells toggled
+         * @throws OutOfBoundsCoordinates if a cell lies outside of the maze
+         * @throws IllegalSpecialCellPosition if the starting cell or a goal cell would become a wall
+         */
+        const ThickMaze toggleCells(const types::CellCollection &cells) const;
+
         static ThickMaze load(std::istream &s);
         void save(std::ostream &s) const;
 
@@ -11,10 +11,14 @@
 #include <types/CommonMazeAttributes.h>
 #include <types/Dimensions2D.h>
 #include <types/AbstractMazeGenerator.h>
+#include <types/AbstractMazeStepper.h>
 
 namespace spelunker::thickmaze {
     class ThickMaze;
 
+    /// A thick maze generation in progress, for generators that support advancing it a bounded amount of work at a time.
+    using ThickMazeStepper = types::AbstractMazeStepper<ThickMaze>;
+
     class ThickMazeGenerator : public types::AbstractMazeGenerator<ThickMaze> {
     public:
         ThickMazeGenerator(const types::Dimensions2D &d);
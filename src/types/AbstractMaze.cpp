@@ -4,6 +4,10 @@
  * By Sebastian Raaphorst, 2018.
  */
 
+#include <algorithm>
+#include <utility>
+#include <vector>
+
 #include "AbstractMaze.h"
 #include "CommonMazeAttributes.h"
 #include "Dimensions2D.h"
@@ -259,6 +263,113 @@ namespace spelunker::types {
         return FurthestCellResults{longestDistance, winners};
     }
 
+    const ChokePoints AbstractMaze::findChokePoints() const noexcept {
+        const auto width = getWidth();
+        const auto height = getHeight();
+        const auto numCells = width * height;
+        const auto unrank = [width](int rk) { return cell(rk % width, rk / width); };
+
+        // Record the passages leaving each cell as a bitmask indexed by dirIdx.
+        std::vector<unsigned char> passages(numCells, 0);
+        for (auto y = 0; y < height; ++y)
+            for (auto x = 0; x < width; ++x) {
+                if (!cellInBounds(cell(x, y))) continue;
+                for (const auto &n: neighbours(cell(x, y)))
+                    passages[y * width + x] |= 1u << dirIdx(cellDirection(cell(x, y), n));
+            }
+        const auto step = [width](int rk, int dir) {
+            switch (dir) {
+                case 0:  return rk - width;
+                case 1:  return rk + 1;
+                case 2:  return rk + width;
+                default: return rk - 1;
+            }
+        };
+
+        // A frame of the depth-first search: the cell, its parent, and the next direction to try.
+        struct Frame {
+            int cell;
+            int parent;
+            int nextDir;
+        };
+
+        std::vector<int> discovered(numCells, -1);
+        std::vector<int> low(numCells, 0);
+        std::vector<int> componentStamp(numCells, -1);
+        std::vector<bool> isArticulation(numCells, false);
+        std::vector<Frame> frames;
+        std::vector<std::pair<int, int>> edges;
+
+        CellPairList bridges;
+        ConnectedComponents components;
+        auto time = 0;
+
+        for (auto root = 0; root < numCells; ++root) {
+            if (discovered[root] != -1 || passages[root] == 0) continue;
+            discovered[root] = low[root] = time++;
+            frames.emplace_back(Frame{root, -1, 0});
+            auto rootChildren = 0;
+
+            while (!frames.empty()) {
+                auto &frame = frames.back();
+                const auto v = frame.cell;
+
+                if (frame.nextDir < 4) {
+                    const auto dir = frame.nextDir++;
+                    if (!(passages[v] & (1u << dir))) continue;
+                    const auto u = step(v, dir);
+                    if (discovered[u] == -1) {
+                        edges.emplace_back(v, u);
+                        discovered[u] = low[u] = time++;
+                        frames.emplace_back(Frame{u, v, 0});
+                    } else if (u != frame.parent && discovered[u] < discovered[v]) {
+                        edges.emplace_back(v, u);
+                        low[v] = std::min(low[v], discovered[u]);
+                    }
+                    continue;
+                }
+
+                // All the passages of v have been explored, so return to its parent.
+                const auto p = frame.parent;
+                frames.pop_back();
+                if (p == -1) continue;
+                low[p] = std::min(low[p], low[v]);
+                if (low[v] < discovered[p]) continue;
+
+                // Nothing below v reaches above p, so p separates v's subtree, and the edges added since {p,v}
+                // form a biconnected component.
+                if (p == root) ++rootChildren;
+                else isArticulation[p] = true;
+                if (low[v] > discovered[p])
+                    bridges.emplace_back(unrank(p), unrank(v));
+
+                const auto id = static_cast<int>(components.size());
+                ConnectedComponent component;
+                for (auto done = false; !done;) {
+                    const auto [a, b] = edges.back();
+                    edges.pop_back();
+                    done = a == p && b == v;
+                    for (const auto c: {a, b})
+                        if (componentStamp[c] != id) {
+                            componentStamp[c] = id;
+                            component.emplace_back(unrank(c));
+                        }
+                }
+                components.emplace_back(std::move(component));
+            }
+
+            if (rootChildren > 1)
+                isArticulation[root] = true;
+        }
+
+        CellCollection articulationCells;
+        for (auto rk = 0; rk < numCells; ++rk)
+            if (isArticulation[rk])
+                articulationCells.emplace_back(unrank(rk));
+
+        return ChokePoints{articulationCells, bridges, components};
+    }
+
 
 //    template<typename Archive>
 //    void AbstractMaze::serialize(Archive &ar, const unsigned int version) {
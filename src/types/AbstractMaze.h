@@ -217,6 +217,18 @@ namespace spelunker::types {
          */
         const FurthestCellResults findDiameter() const noexcept;
 
+        /// Find the choke points of the maze.
+        /**
+         * Find the articulation cells, bridges, and biconnected components of the maze using the algorithm of
+         * Hopcroft and Tarjan, which runs in time linear in the number of cells. The depth-first search is performed
+         * with an explicit stack rather than by recursion, so very large mazes can be processed.
+         *
+         * Cells without passages belong to no biconnected component.
+         *
+         * @return a structure with the articulation cells, bridges, and biconnected components
+         */
+        const ChokePoints findChokePoints() const noexcept;
+
     protected:
         /**
          * Empty constructor for Boost.Serialization.
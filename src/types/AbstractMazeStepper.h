@@ -0,0 +1,104 @@
+/**
+ * AbstractMazeStepper.h
+ *
+ * By Sebastian Raaphorst, 2018.
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <limits>
+
+#include "Dimensions2D.h"
+
+namespace spelunker::types {
+    /**
+     * A maze generation in progress, which can be advanced a bounded amount of work at a time, e.g. across the frames
+     * of a game, instead of all at once as by @see{AbstractMazeGenerator::generate}. The maze can be inspected at any
+     * point, which shows the work done so far.
+     *
+     * Subclasses implement @see{run}, which performs a number of the steps of the algorithm. What constitutes a step
+     * depends on the algorithm, but each does a bounded amount of work.
+     *
+     * @tparam T the type of maze being generated
+     */
+    template<typename T>
+    class AbstractMazeStepper {
+    protected:
+        AbstractMazeStepper(const types::Dimensions2D &d)
+            : dimensions{d} {}
+
+    public:
+        using Clock = std::chrono::steady_clock;
+
+        virtual ~AbstractMazeStepper() = default;
+
+        inline const Dimensions2D &getDimensions() const noexcept {
+            return dimensions;
+        }
+
+        /// Determine if the generation is complete.
+        virtual bool isDone() const noexcept = 0;
+
+        /// The number of steps performed so far.
+        inline std::uint64_t getNumSteps() const noexcept {
+            return numSteps;
+        }
+
+        /**
+         * Perform at most the given number of steps.
+         * @param maxSteps the maximum number of steps to perform
+         * @return true if the generation is complete, and false otherwise
+         */
+        bool advance(const std::uint64_t maxSteps) {
+            if (!isDone() && maxSteps > 0)
+                numSteps += run(maxSteps);
+            return isDone();
+        }
+
+        /**
+         * Perform steps until the time budget is exhausted. Steps are run in batches, which grow while they take only
+         * a small fraction of the remaining budget, so that reading the clock does not dominate.
+         * @param budget the time available
+         * @return true if the generation is complete, and false otherwise
+         */
+        bool advance(const Clock::duration budget) {
+            const auto deadline = Clock::now() + budget;
+            std::uint64_t batch = 1;
+            for (auto start = Clock::now(); !isDone() && start < deadline;) {
+                advance(batch);
+                const auto end = Clock::now();
+                if ((end - start) * 8 < deadline - end && batch < maxBatch)
+                    batch *= 2;
+                else if ((end - start) * 2 > deadline - end && batch > 1)
+                    batch /= 2;
+                start = end;
+            }
+            return isDone();
+        }
+
+        /// Run the generation to completion.
+        inline void finish() {
+            advance(std::numeric_limits<std::uint64_t>::max());
+        }
+
+        /// The maze as generated so far, which is the generated maze once the generation is done.
+        virtual const T current() const = 0;
+
+    protected:
+        /**
+         * Perform at most the given number of steps of the algorithm.
+         * @param maxSteps the maximum number of steps to perform, which is positive
+         * @return the number of steps performed, which is less than maxSteps only if the generation is now complete
+         */
+        virtual std::uint64_t run(std::uint64_t maxSteps) = 0;
+
+    private:
+        /// The largest batch of steps between reads of the clock.
+        static constexpr std::uint64_t maxBatch = std::uint64_t{1} << 20;
+
+        const Dimensions2D dimensions;
+        std::uint64_t numSteps = 0;
+    };
+}
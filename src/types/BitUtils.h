@@ -0,0 +1,73 @@
+/**
+ * BitUtils.h
+ *
+ * By Sebastian Raaphorst, 2018.
+ *
+ * Helpers for algorithms that store cells as bits packed into 64-bit words.
+ */
+
+#pragma once
+
+#include <cstdint>
+
+namespace spelunker::types {
+    /// The number of bits in a word of a packed bitmap.
+    constexpr int WordBits = 64;
+
+    /// The number of words needed to hold n bits, computed in the type of n so that large bitmaps do not overflow.
+    template<typename T>
+    constexpr T numWords(const T n) noexcept {
+        return (n + WordBits - 1) / WordBits;
+    }
+
+    /// The index of the lowest set bit of a nonzero word.
+    inline int countTrailingZeros(const std::uint64_t word) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+        return __builtin_ctzll(word);
+#else
+        auto n = 0;
+        for (auto w = word; !(w & 1u); w >>= 1u)
+            ++n;
+        return n;
+#endif
+    }
+
+    /// The index of the highest set bit of a nonzero word.
+    inline int highestSetBit(const std::uint64_t word) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+        return WordBits - 1 - __builtin_clzll(word);
+#else
+        auto n = 0;
+        for (auto w = word >> 1u; w; w >>= 1u)
+            ++n;
+        return n;
+#endif
+    }
+
+    /// The number of set bits in a word.
+    inline int popCount(const std::uint64_t word) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+        return __builtin_popcountll(word);
+#else
+        auto n = 0;
+        for (auto w = word; w; w &= w - 1)
+            ++n;
+        return n;
+#endif
+    }
+
+    /// Test bit i of a packed bitmap.
+    inline bool testBit(const std::uint64_t *bits, const int i) noexcept {
+        return (bits[i / WordBits] >> (i % WordBits)) & 1u;
+    }
+
+    /// Set bit i of a packed bitmap.
+    inline void setBit(std::uint64_t *bits, const int i) noexcept {
+        bits[i / WordBits] |= std::uint64_t{1} << (i % WordBits);
+    }
+
+    /// Clear bit i of a packed bitmap.
+    inline void clearBit(std::uint64_t *bits, const int i) noexcept {
+        bits[i / WordBits] &= ~(std::uint64_t{1} << (i % WordBits));
+    }
+}
@@ -104,6 +104,22 @@ namespace spelunker::types {
         const CellPairList cellList;
     };
 
+    /// A structure to provide the choke points of a maze.
+    /**
+     * This structure describes the cut cells and cut passages of a maze, i.e. those whose removal would disconnect
+     * the maze, and its biconnected components, which are the maximal regions containing no choke points.
+     * 1. articulationCells are the cells whose removal would disconnect their connected component;
+     * 2. bridges are the pairs of adjacent cells such that closing the passage between them would disconnect their
+     *    connected component; and
+     * 3. biconnectedComponents are the cells of each biconnected component. Each articulation cell is shared by
+     *    every component that meets at it, and each bridge forms a component of its own.
+     */
+    struct ChokePoints {
+        const CellCollection articulationCells;
+        const CellPairList bridges;
+        const ConnectedComponents biconnectedComponents;
+    };
+
     /// A position in a maze, i.e. a Cell and a Direction.
     using Position = std::pair<Cell, Direction>;
 
@@ -0,0 +1,315 @@
+/**
+ * ContractionHierarchy.cpp
+ *
+ * By Sebastian Raaphorst, 2018.
+ */
+
+#include <algorithm>
+#include <functional>
+#include <queue>
+#include <stack>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "AbstractMaze.h"
+#include "CommonMazeAttributes.h"
+#include "Parallel.h"
+#include "ContractionHierarchy.h"
+
+namespace spelunker::types {
+    namespace {
+        /// An edge of the graph during contraction, or an upward edge of the hierarchy.
+        struct Arc {
+            int to;
+            int weight;
+        };
+        using Adjacency = std::vector<std::vector<Arc>>;
+
+        /// A shortcut {from,to} of the given weight, replacing the path through middle.
+        struct Shortcut {
+            int from;
+            int to;
+            int weight;
+            int middle;
+        };
+
+        /// The maximum number of cells a witness search may settle before we give up and add the shortcut.
+        constexpr int WitnessSettleLimit = 64;
+
+        using MinQueue = std::priority_queue<std::pair<int, int>, std::vector<std::pair<int, int>>, std::greater<>>;
+
+        /**
+         * Determine the shortcuts needed to contract a cell v.
+         * For every pair of neighbours {a,b} of v, we search for a witness path from a to b that avoids v and is no
+         * longer than the path through v. If none is found, the shortcut is needed.
+         *
+         * Witness paths must also avoid every other cell being contracted in the same round: otherwise the witness for
+         * one contraction could run through another whose own witness runs through the first, and both would wrongly
+         * omit their shortcuts.
+         */
+        void findShortcuts(const Adjacency &adj, const int v, const std::vector<char> &contracting,
+                           std::vector<Shortcut> &shortcuts, std::unordered_map<int, int> &dist) {
+            shortcuts.clear();
+            const auto &nbrs = adj[v];
+            for (auto i = 0; i < static_cast<int>(nbrs.size()); ++i) {
+                const auto a = nbrs[i].to;
+
+                auto bound = 0;
+                for (auto j = i + 1; j < static_cast<int>(nbrs.size()); ++j)
+                    bound = std::max(bound, nbrs[i].weight + nbrs[j].weight);
+                if (bound == 0) continue;
+
+                // A Dijkstra search from a, avoiding v, limited in both distance and number of cells settled.
+                dist.clear();
+                MinQueue queue;
+                dist[a] = 0;
+                queue.emplace(0, a);
+                for (auto settled = 0; !queue.empty() && settled < WitnessSettleLimit; ++settled) {
+                    const auto [d, u] = queue.top();
+                    queue.pop();
+                    if (d > dist[u]) continue;
+                    if (d > bound) break;
+                    for (const auto &arc: adj[u]) {
+                        if (arc.to == v || contracting[arc.to]) continue;
+                        const auto nd = d + arc.weight;
+                        const auto iter = dist.find(arc.to);
+                        if (iter == dist.end() || nd < iter->second) {
+                            dist[arc.to] = nd;
+                            queue.emplace(nd, arc.to);
+                        }
+                    }
+                }
+
+                for (auto j = i + 1; j < static_cast<int>(nbrs.size()); ++j) {
+                    const auto b = nbrs[j].to;
+                    const auto via = nbrs[i].weight + nbrs[j].weight;
+                    const auto iter = dist.find(b);
+                    if (iter == dist.end() || iter->second > via)
+                        shortcuts.emplace_back(Shortcut{a, b, via, v});
+                }
+            }
+        }
+    }
+
+    ContractionHierarchy::ContractionHierarchy(const AbstractMaze &m, const unsigned int numThreads)
+            : dimensions{m.getDimensions()}, numShortcuts{0} {
+        const auto width = m.getWidth();
+        const auto height = m.getHeight();
+        const auto numCells = width * height;
+        const auto threads = numThreads == 0 ? defaultNumThreads() : numThreads;
+
+        // Build the cell graph: every passage is an edge of weight 1.
+        Adjacency adj(numCells);
+        for (auto y = 0; y < height; ++y)
+            for (auto x = 0; x < width; ++x)
+                if (m.cellInBounds(x, y))
+                    for (const auto &[nx, ny]: m.neighbours(cell(x, y)))
+                        adj[y * width + x].emplace_back(Arc{ny * width + nx, 1});
+
+        // The priority of a cell is its edge difference, i.e. the number of shortcuts its contraction would add
+        // less the number of edges it would remove, plus the number of its neighbours already contracted to keep
+        // the contraction spread out evenly over the maze.
+        std::vector<int> deleted(numCells, 0);
+        std::vector<int> priority(numCells, 0);
+        std::vector<std::vector<Shortcut>> shortcutBuffers(threads);
+        std::vector<std::unordered_map<int, int>> distBuffers(threads);
+        std::vector<char> isSelected(numCells, false);
+
+        const auto updatePriorities = [&](const std::vector<int> &cells) {
+            parallelFor(0, static_cast<int>(cells.size()), threads, [&](int block, int begin, int end) {
+                for (auto i = begin; i < end; ++i) {
+                    const auto v = cells[i];
+                    findShortcuts(adj, v, isSelected, shortcutBuffers[block], distBuffers[block]);
+                    priority[v] = static_cast<int>(shortcutBuffers[block].size())
+                                  - static_cast<int>(adj[v].size()) + deleted[v];
+                }
+            });
+        };
+
+        std::vector<int> remaining(numCells);
+        for (auto v = 0; v < numCells; ++v)
+            remaining[v] = v;
+        updatePriorities(remaining);
+
+        const auto precedes = [&priority](int u, int v) {
+            return std::make_pair(priority[u], u) < std::make_pair(priority[v], v);
+        };
+
+        // Add or improve the edge {a,b} during contraction.
+        const auto addShortcut = [&](const Shortcut &sc) {
+            auto &arcs = adj[sc.from];
+            const auto iter = std::find_if(arcs.begin(), arcs.end(), [&sc](const Arc &a) { return a.to == sc.to; });
+            if (iter != arcs.end()) {
+                if (iter->weight <= sc.weight) return;
+                iter->weight = sc.weight;
+                for (auto &a: adj[sc.to])
+                    if (a.to == sc.from) a.weight = sc.weight;
+            } else {
+                arcs.emplace_back(Arc{sc.to, sc.weight});
+                adj[sc.to].emplace_back(Arc{sc.from, sc.weight});
+                ++numShortcuts;
+            }
+            middles[arcKey(sc.from, sc.to)] = sc.middle;
+        };
+
+        Adjacency up(numCells);
+        std::vector<char> isTouched(numCells, false);
+        while (!remaining.empty()) {
+            // Select the cells that precede all of their remaining neighbours: they form an independent set.
+            parallelFor(0, static_cast<int>(remaining.size()), threads, [&](int, int begin, int end) {
+                for (auto i = begin; i < end; ++i) {
+                    const auto v = remaining[i];
+                    isSelected[v] = std::all_of(adj[v].cbegin(), adj[v].cend(),
+                                                [&](const Arc &a) { return precedes(v, a.to); });
+                }
+            });
+            std::vector<int> selected;
+            std::copy_if(remaining.cbegin(), remaining.cend(), std::back_inserter(selected),
+                         [&isSelected](int v) { return isSelected[v]; });
+
+            // Compute the shortcuts for each selected cell concurrently: the graph is only read here.
+            std::vector<std::vector<Shortcut>> shortcuts(selected.size());
+            parallelFor(0, static_cast<int>(selected.size()), threads, [&](int block, int begin, int end) {
+                for (auto i = begin; i < end; ++i)
+                    findShortcuts(adj, selected[i], isSelected, shortcuts[i], distBuffers[block]);
+            });
+
+            // Contract the selected cells: their remaining edges all lead upward in the hierarchy.
+            std::vector<int> touched;
+            for (const auto v: selected) {
+                up[v] = std::move(adj[v]);
+                adj[v].clear();
+                for (const auto &arc: up[v]) {
+                    auto &arcs = adj[arc.to];
+                    arcs.erase(std::remove_if(arcs.begin(), arcs.end(), [v](const Arc &a) { return a.to == v; }),
+                               arcs.end());
+                    ++deleted[arc.to];
+                    if (!isTouched[arc.to]) {
+                        isTouched[arc.to] = true;
+                        touched.emplace_back(arc.to);
+                    }
+                }
+            }
+            for (const auto &scs: shortcuts)
+                for (const auto &sc: scs)
+                    addShortcut(sc);
+
+            remaining.erase(std::remove_if(remaining.begin(), remaining.end(),
+                                           [&isSelected](int v) { return isSelected[v]; }),
+                            remaining.end());
+            for (const auto v: touched)
+                isTouched[v] = false;
+            updatePriorities(touched);
+        }
+
+        // Flatten the upward graph.
+        upOffsets.reserve(numCells + 1);
+        upOffsets.emplace_back(0);
+        for (const auto &arcs: up) {
+            for (const auto &arc: arcs) {
+                upTargets.emplace_back(arc.to);
+                upWeights.emplace_back(arc.weight);
+            }
+            upOffsets.emplace_back(static_cast<int>(upTargets.size()));
+        }
+    }
+
+    int ContractionHierarchy::rankCell(const Cell &c) const {
+        dimensions.checkCell(c);
+        return c.second * dimensions.getWidth() + c.first;
+    }
+
+    int ContractionHierarchy::search(const int s, const int t, Labels &forward, Labels &backward, int &meet) const {
+        forward[s] = Label{0, -1};
+        backward[t] = Label{0, -1};
+        MinQueue forwardQueue;
+        MinQueue backwardQueue;
+        forwardQueue.emplace(0, s);
+        backwardQueue.emplace(0, t);
+
+        auto best = -1;
+        const auto done = [&best](const MinQueue &q) {
+            return q.empty() || (best != -1 && q.top().first >= best);
+        };
+
+        // Alternate between the directions, always advancing the one with the closer frontier.
+        while (!done(forwardQueue) || !done(backwardQueue)) {
+            const auto useForward = done(backwardQueue)
+                                    || (!done(forwardQueue) && forwardQueue.top().first <= backwardQueue.top().first);
+            auto &queue = useForward ? forwardQueue : backwardQueue;
+            auto &labels = useForward ? forward : backward;
+            const auto &other = useForward ? backward : forward;
+
+            const auto [d, u] = queue.top();
+            queue.pop();
+            if (d > labels[u].distance) continue;
+
+            const auto iter = other.find(u);
+            if (iter != other.end() && (best == -1 || d + iter->second.distance < best)) {
+                best = d + iter->second.distance;
+                meet = u;
+            }
+
+            for (auto i = upOffsets[u]; i < upOffsets[u + 1]; ++i) {
+                const auto v = upTargets[i];
+                const auto nd = d + upWeights[i];
+                const auto viter = labels.find(v);
+                if (viter == labels.end() || nd < viter->second.distance) {
+                    labels[v] = Label{nd, u};
+                    queue.emplace(nd, v);
+                }
+            }
+        }
+        return best;
+    }
+
+    int ContractionHierarchy::distance(const Cell &from, const Cell &to) const {
+        const auto s = rankCell(from);
+        const auto t = rankCell(to);
+        Labels forward;
+        Labels backward;
+        auto meet = -1;
+        return search(s, t, forward, backward, meet);
+    }
+
+    const CellCollection ContractionHierarchy::shortestPath(const Cell &from, const Cell &to) const {
+        const auto s = rankCell(from);
+        const auto t = rankCell(to);
+        Labels forward;
+        Labels backward;
+        auto meet = -1;
+        if (search(s, t, forward, backward, meet) == -1)
+            return CellCollection{};
+
+        // Recover the path through the hierarchy: up from s to the meeting cell, and then down to t.
+        std::vector<int> ranks;
+        for (auto v = meet; v != -1; v = forward[v].predecessor)
+            ranks.emplace_back(v);
+        std::reverse(ranks.begin(), ranks.end());
+        for (auto v = backward[meet].predecessor; v != -1; v = backward[v].predecessor)
+            ranks.emplace_back(v);
+
+        // Unpack each shortcut into the two edges that it replaced until only edges of the maze remain.
+        const auto width = dimensions.getWidth();
+        const auto unrank = [width](int rk) { return cell(rk % width, rk / width); };
+
+        CellCollection path{from};
+        std::stack<std::pair<int, int>> arcs;
+        for (auto i = 0; i + 1 < static_cast<int>(ranks.size()); ++i) {
+            arcs.emplace(ranks[i], ranks[i + 1]);
+            while (!arcs.empty()) {
+                const auto [u, v] = arcs.top();
+                arcs.pop();
+                const auto iter = middles.find(arcKey(u, v));
+                if (iter == middles.end()) {
+                    path.emplace_back(unrank(v));
+                } else {
+                    arcs.emplace(iter->second, v);
+                    arcs.emplace(u, iter->second);
+                }
+            }
+        }
+        return path;
+    }
+}
@@ -0,0 +1,106 @@
+/**
+ * ContractionHierarchy.h
+ *
+ * By Sebastian Raaphorst, 2018.
+ *
+ * A contraction hierarchy over the cell graph of a maze, for fast repeated shortest path queries.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "AbstractMaze.h"
+#include "CommonMazeAttributes.h"
+
+namespace spelunker::types {
+    /**
+     * A contraction hierarchy (CH) over the cells of a maze.
+     *
+     * Perfect mazes have a unique path between any two cells, but braid mazes and cellular automaton caves do not,
+     * and answering many shortest path queries with BFS quickly becomes prohibitive. A CH is built once by
+     * contracting the cells one at a time in order of importance, adding shortcut edges whenever a shortest path
+     * passed through the contracted cell. Queries then consist of two small Dijkstra searches, one from each end,
+     * that only ever move towards more important cells and meet in the middle.
+     *
+     * Cells are contracted in rounds: in each round, every cell whose priority is lower than that of all of its
+     * remaining neighbours is contracted, and since these cells form an independent set, their shortcuts can be
+     * computed concurrently.
+     *
+     * Once built, the hierarchy is immutable, and queries may be run concurrently from multiple threads.
+     */
+    class ContractionHierarchy final {
+    public:
+        /**
+         * Build the contraction hierarchy for the cell graph of a maze.
+         * @param m the maze
+         * @param numThreads the number of threads to use to order the cells (0 meaning one per hardware thread)
+         */
+        explicit ContractionHierarchy(const AbstractMaze &m, unsigned int numThreads = 0);
+
+        /**
+         * Find the length of the shortest path between two cells.
+         * @param from the starting cell
+         * @param to the destination cell
+         * @return the number of moves from from to to, or -1 if there is no path
+         * @throws OutOfBoundsCoordinates if either cell is outside of the maze
+         */
+        int distance(const Cell &from, const Cell &to) const;
+
+        /**
+         * Find a shortest path between two cells by unpacking the shortcuts used back to cells of the maze.
+         * @param from the starting cell
+         * @param to the destination cell
+         * @return the cells on the path, from from to to inclusive, or an empty collection if there is no path
+         * @throws OutOfBoundsCoordinates if either cell is outside of the maze
+         */
+        const CellCollection shortestPath(const Cell &from, const Cell &to) const;
+
+        /// The number of shortcuts added while contracting the maze.
+        inline int getNumShortcuts() const noexcept {
+            return numShortcuts;
+        }
+
+    private:
+        /// The distance and the predecessor of a cell reached in one direction of a query.
+        struct Label {
+            int distance;
+            int predecessor;
+        };
+        using Labels = std::unordered_map<int, Label>;
+
+        /**
+         * Run the bidirectional upward search between two ranked cells.
+         * @param s the rank of the starting cell
+         * @param t the rank of the destination cell
+         * @param forward the labels reached from s
+         * @param backward the labels reached from t
+         * @param meet the rank of the cell where the shortest path peaks, if one exists
+         * @return the distance, or -1 if there is no path
+         */
+        int search(int s, int t, Labels &forward, Labels &backward, int &meet) const;
+
+        /// Check that a cell is in the maze, and rank it.
+        int rankCell(const Cell &c) const;
+
+        /// The key under which the contracted middle of a shortcut {u,v} is stored.
+        static inline std::uint64_t arcKey(int u, int v) noexcept {
+            if (u > v) std::swap(u, v);
+            return (static_cast<std::uint64_t>(u) << 32) | static_cast<std::uint32_t>(v);
+        }
+
+        const Dimensions2D dimensions;
+
+        /// The arcs leading upward in the hierarchy from each cell, in compressed sparse row form.
+        std::vector<int> upOffsets;
+        std::vector<int> upTargets;
+        std::vector<int> upWeights;
+
+        /// For each shortcut, the cell that was contracted to create it.
+        std::unordered_map<std::uint64_t, int> middles;
+
+        int numShortcuts;
+    };
+}
@@ -0,0 +1,80 @@
+/**
+ * DisjointSets.h
+ *
+ * By Sebastian Raaphorst, 2018.
+ *
+ * A flat union-find structure over the integers [0, n).
+ */
+
+#pragma once
+
+#include <utility>
+#include <vector>
+
+namespace spelunker::types {
+    /**
+     * Disjoint sets over the elements [0, n), typically the ranks of the cells of a maze.
+     *
+     * The structure consists of nothing but a parent and a size for each element, stored contiguously, so it is far
+     * more cache friendly than a node-based implementation. Finds use path halving and unions are by size, so any
+     * sequence of operations runs in effectively constant amortized time per operation.
+     */
+    class DisjointSets final {
+    public:
+        /// Create n singleton sets.
+        explicit DisjointSets(const int n)
+                : parent(n), sizes(n, 1), numSets{n} {
+            for (auto i = 0; i < n; ++i)
+                parent[i] = i;
+        }
+
+        /// Find the representative of the set containing x, halving the path to it along the way.
+        inline int find(int x) noexcept {
+            while (parent[x] != x) {
+                parent[x] = parent[parent[x]];
+                x = parent[x];
+            }
+            return x;
+        }
+
+        /**
+         * Merge the sets containing x and y.
+         * @return true if they were in different sets, and false if they were already in the same set
+         */
+        inline bool unite(int x, int y) noexcept {
+            x = find(x);
+            y = find(y);
+            if (x == y)
+                return false;
+            if (sizes[x] < sizes[y])
+                std::swap(x, y);
+            parent[y] = x;
+            sizes[x] += sizes[y];
+            --numSets;
+            return true;
+        }
+
+        /// Determine if x and y are in the same set.
+        inline bool connected(const int x, const int y) noexcept {
+            return find(x) == find(y);
+        }
+
+        /// The number of elements in the set containing x.
+        inline int setSize(const int x) noexcept {
+            return sizes[find(x)];
+        }
+
+        inline int getNumElements() const noexcept {
+            return static_cast<int>(parent.size());
+        }
+
+        inline int getNumSets() const noexcept {
+            return numSets;
+        }
+
+    private:
+        std::vector<int> parent;
+        std::vector<int> sizes;
+        int numSets;
+    };
+}
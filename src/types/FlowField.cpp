@@ -0,0 +1,276 @@
+/**
+ * FlowField.cpp
+ *
+ * By Sebastian Raaphorst, 2018.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <queue>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "AbstractMaze.h"
+#include "CommonMazeAttributes.h"
+#include "Direction.h"
+#include "Parallel.h"
+#include "FlowField.h"
+
+namespace spelunker::types {
+    namespace {
+        using MinQueue = std::priority_queue<std::pair<std::uint64_t, int>,
+                                             std::vector<std::pair<std::uint64_t, int>>,
+                                             std::greater<>>;
+
+        constexpr auto OverflowMessage = "FlowField: distance too large for the distance type";
+    }
+
+    template<typename Distance>
+    FlowField<Distance>::FlowField(const AbstractMaze &m, const unsigned int numThreads)
+            : FlowField{m, m.getGoalCells(), numThreads} {}
+
+    template<typename Distance>
+    FlowField<Distance>::FlowField(const AbstractMaze &m, const CellCollection &goals, const unsigned int numThreads)
+            : dimensions{m.getDimensions()},
+              width{m.getWidth()},
+              height{m.getHeight()},
+              rowBytes{(m.getWidth() + 3) / 4},
+              goals{checkGoals(goals)},
+              passages(width * height, 0),
+              distances(width * height, Unreachable),
+              directions(rowBytes * height, 0) {
+        parallelFor(0, height, numThreads, [this, &m](int, int y0, int y1) {
+            for (auto y = y0; y < y1; ++y)
+                for (auto x = 0; x < width; ++x) {
+                    if (!m.cellInBounds(cell(x, y)))
+                        continue;
+                    auto &mask = passages[y * width + x];
+                    for (const auto &[nx, ny]: m.neighbours(cell(x, y))) {
+                        if (ny < y)      mask |= 1u << dirIdx(Direction::NORTH);
+                        else if (nx > x) mask |= 1u << dirIdx(Direction::EAST);
+                        else if (ny > y) mask |= 1u << dirIdx(Direction::SOUTH);
+                        else             mask |= 1u << dirIdx(Direction::WEST);
+                    }
+                }
+        });
+        rebuild(numThreads);
+    }
+
+    template<typename Distance>
+    const CellCollection FlowField<Distance>::checkGoals(const CellCollection &cs) const {
+        for (const auto &c: cs)
+            dimensions.checkCell(c);
+        CellCollection sorted{cs};
+        std::sort(sorted.begin(), sorted.end());
+        sorted.erase(std::unique(sorted.begin(), sorted.end()), sorted.end());
+        return sorted;
+    }
+
+    template<typename Distance>
+    void FlowField<Distance>::updateDirection(const int rk) noexcept {
+        const auto d = distances[rk];
+        auto dir = 0;
+        if (d != 0 && d != Unreachable)
+            for (; dir < 4; ++dir)
+                if ((passages[rk] & (1u << dir)) && distances[step(rk, dir)] == d - 1)
+                    break;
+
+        const auto x = rk % width;
+        auto &byte = directions[(rk / width) * rowBytes + x / 4];
+        const auto shift = 2 * (x % 4);
+        byte = static_cast<std::uint8_t>((byte & ~(3u << shift)) | ((dir & 3u) << shift));
+    }
+
+    template<typename Distance>
+    void FlowField<Distance>::updateDirections(const int y0, const int y1) noexcept {
+        for (auto rk = y0 * width; rk < y1 * width; ++rk)
+            updateDirection(rk);
+    }
+
+    template<typename Distance>
+    void FlowField<Distance>::rebuild(const unsigned int numThreads) {
+        std::fill(distances.begin(), distances.end(), Unreachable);
+        for (const auto &[x, y]: goals)
+            distances[y * width + x] = 0;
+
+        const auto numStripes = static_cast<int>(std::min<unsigned int>(
+                numThreads == 0 ? defaultNumThreads() : numThreads, static_cast<unsigned int>(height)));
+        const auto stripeBegin = [this, numStripes](int s) {
+            return static_cast<int>(static_cast<long long>(height) * s / numStripes);
+        };
+        std::atomic<bool> overflow{false};
+
+        // Relax the distances in the stripe of rows [y0, y1) outward from the given seeds, without leaving the stripe.
+        const auto relax = [this, &overflow](MinQueue &queue, int y0, int y1) {
+            while (!queue.empty()) {
+                const auto [d, u] = queue.top();
+                queue.pop();
+                if (d > distances[u]) continue;
+                if (d + 1 >= Unreachable) {
+                    overflow = true;
+                    continue;
+                }
+                for (auto dir = 0; dir < 4; ++dir) {
+                    if (!(passages[u] & (1u << dir))) continue;
+                    const auto v = step(u, dir);
+                    if (v < y0 * width || v >= y1 * width || distances[v] <= d + 1) continue;
+                    distances[v] = static_cast<Distance>(d + 1);
+                    queue.emplace(d + 1, v);
+                }
+            }
+        };
+
+        if (numStripes <= 1) {
+            MinQueue queue;
+            for (const auto &[x, y]: goals)
+                queue.emplace(0, y * width + x);
+            relax(queue, 0, height);
+        } else {
+            // Each stripe repeatedly runs its own search, seeded by the distances its neighbouring stripes had on
+            // their shared edges at the end of the previous round. Once no edge row changes, all stripes agree.
+            std::vector<Distance> firstRows(numStripes * width, Unreachable);
+            std::vector<Distance> lastRows(numStripes * width, Unreachable);
+            for (auto round = 0, changed = 1; changed; ++round) {
+                parallelFor(0, numStripes, numStripes, [&](int, int sBegin, int sEnd) {
+                    for (auto s = sBegin; s < sEnd; ++s) {
+                        const auto y0 = stripeBegin(s);
+                        const auto y1 = stripeBegin(s + 1);
+                        MinQueue queue;
+                        if (round == 0) {
+                            for (const auto &[x, y]: goals)
+                                if (y0 <= y && y < y1)
+                                    queue.emplace(0, y * width + x);
+                        }
+
+                        const auto seed = [&](int rk, int dir, Distance nd) {
+                            if ((passages[rk] & (1u << dir)) && nd != Unreachable && nd + 1u < distances[rk]) {
+                                distances[rk] = static_cast<Distance>(nd + 1);
+                                queue.emplace(nd + 1, rk);
+                            }
+                        };
+                        for (auto x = 0; x < width; ++x) {
+                            if (s > 0)
+                                seed(y0 * width + x, dirIdx(Direction::NORTH), lastRows[(s - 1) * width + x]);
+                            if (s < numStripes - 1)
+                                seed((y1 - 1) * width + x, dirIdx(Direction::SOUTH), firstRows[(s + 1) * width + x]);
+                        }
+                        relax(queue, y0, y1);
+                    }
+                });
+
+                changed = 0;
+                for (auto s = 0; s < numStripes; ++s) {
+                    const auto first = distances.cbegin() + stripeBegin(s) * width;
+                    const auto last = distances.cbegin() + (stripeBegin(s + 1) - 1) * width;
+                    const auto firstRow = firstRows.begin() + s * width;
+                    const auto lastRow = lastRows.begin() + s * width;
+                    if (!std::equal(first, first + width, firstRow) || !std::equal(last, last + width, lastRow)) {
+                        changed = 1;
+                        std::copy(first, first + width, firstRow);
+                        std::copy(last, last + width, lastRow);
+                    }
+                }
+            }
+        }
+
+        parallelFor(0, height, numThreads, [this](int, int y0, int y1) { updateDirections(y0, y1); });
+        if (overflow)
+            throw std::overflow_error(OverflowMessage);
+    }
+
+    template<typename Distance>
+    void FlowField<Distance>::setGoals(const CellCollection &newGoals) {
+        auto nextGoals = checkGoals(newGoals);
+        CellCollection removed;
+        CellCollection added;
+        std::set_difference(goals.cbegin(), goals.cend(), nextGoals.cbegin(), nextGoals.cend(),
+                            std::back_inserter(removed));
+        std::set_difference(nextGoals.cbegin(), nextGoals.cend(), goals.cbegin(), goals.cend(),
+                            std::back_inserter(added));
+        goals = std::move(nextGoals);
+
+        // Invalidate every cell that flowed to a removed goal: these form a subtree of the direction field.
+        std::vector<int> invalidated;
+        std::vector<int> stack;
+        for (const auto &[x, y]: removed)
+            stack.emplace_back(y * width + x);
+        while (!stack.empty()) {
+            const auto u = stack.back();
+            stack.pop_back();
+            for (auto dir = 0; dir < 4; ++dir) {
+                if (!(passages[u] & (1u << dir))) continue;
+                const auto v = step(u, dir);
+                const auto vx = v % width;
+                if (distances[v] == distances[u] + 1
+                    && dirIdx(direction(vx, v / width)) == dirIdx(flip(static_cast<Direction>(dir))))
+                    stack.emplace_back(v);
+            }
+            distances[u] = Unreachable;
+            invalidated.emplace_back(u);
+        }
+
+        // Seed the invalidated cells from their valid neighbours, and the added goals, and lower distances from there.
+        std::vector<std::pair<int, Distance>> seeds;
+        for (const auto u: invalidated) {
+            auto best = Unreachable;
+            for (auto dir = 0; dir < 4; ++dir)
+                if (passages[u] & (1u << dir))
+                    best = std::min(best, distances[step(u, dir)]);
+            if (best != Unreachable)
+                seeds.emplace_back(u, best);
+        }
+
+        auto overflow = false;
+        MinQueue queue;
+        for (const auto &[u, best]: seeds) {
+            if (best + 1u >= Unreachable) {
+                overflow = true;
+                continue;
+            }
+            distances[u] = static_cast<Distance>(best + 1);
+            queue.emplace(best + 1, u);
+        }
+        for (const auto &[x, y]: added) {
+            const auto u = y * width + x;
+            distances[u] = 0;
+            queue.emplace(0, u);
+        }
+
+        std::vector<int> changed{invalidated};
+        while (!queue.empty()) {
+            const auto [d, u] = queue.top();
+            queue.pop();
+            if (d > distances[u]) continue;
+            changed.emplace_back(u);
+            if (d + 1 >= Unreachable) {
+                overflow = true;
+                continue;
+            }
+            for (auto dir = 0; dir < 4; ++dir) {
+                if (!(passages[u] & (1u << dir))) continue;
+                const auto v = step(u, dir);
+                if (distances[v] <= d + 1) continue;
+                distances[v] = static_cast<Distance>(d + 1);
+                queue.emplace(d + 1, v);
+            }
+        }
+
+        // The direction of a cell depends on its neighbours' distances, so update around every changed cell.
+        for (const auto u: changed) {
+            updateDirection(u);
+            for (auto dir = 0; dir < 4; ++dir)
+                if (passages[u] & (1u << dir))
+                    updateDirection(step(u, dir));
+        }
+
+        if (overflow)
+            throw std::overflow_error(OverflowMessage);
+    }
+
+    template class FlowField<std::uint16_t>;
+    template class FlowField<std::uint32_t>;
+}
@@ -0,0 +1,161 @@
+/**
+ * FlowField.h
+ *
+ * By Sebastian Raaphorst, 2018.
+ *
+ * A flow field over a maze: for every cell, the distance to the nearest goal and the direction in which to move.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include <vector>
+
+#include "AbstractMaze.h"
+#include "CommonMazeAttributes.h"
+#include "Direction.h"
+
+namespace spelunker::types {
+    /**
+     * A flow field for a set of goal cells in a maze.
+     *
+     * Any number of agents heading for the same goals can share a flow field instead of each performing its own
+     * search: an agent simply moves in the direction stored for its cell. The field is computed by a single BFS
+     * backwards from all the goals at once, and is stored compactly as:
+     * 1. a distance for each cell, of type Distance (16 or 32 bits); and
+     * 2. a direction for each cell, packed into 2 bits, with each row padded to a whole number of bytes.
+     *
+     * The direction stored for a cell is the first of NORTH, EAST, SOUTH, WEST that leads to a cell one move closer
+     * to a goal. It is meaningless for goals and unreachable cells, which can be recognized by their distances.
+     *
+     * The field can be rebuilt in parallel, with each thread responsible for a horizontal stripe of the maze, and can
+     * be updated incrementally when the goals move, which only touches the cells whose distances change.
+     *
+     * The passages of the maze are captured on construction, so the maze need not outlive the flow field.
+     *
+     * @tparam Distance the unsigned type used to store distances
+     */
+    template<typename Distance>
+    class FlowField final {
+        static_assert(std::is_unsigned_v<Distance>, "FlowField distances must be unsigned");
+
+    public:
+        /// The distance recorded for cells from which no goal can be reached.
+        static constexpr Distance Unreachable = std::numeric_limits<Distance>::max();
+
+        /**
+         * Create the flow field for the goal cells of the maze.
+         * @param m the maze
+         * @param numThreads the number of threads to use (0 meaning one per hardware thread)
+         * @throws std::overflow_error if a distance cannot be represented by Distance
+         */
+        explicit FlowField(const AbstractMaze &m, unsigned int numThreads = 0);
+
+        /**
+         * Create the flow field for the given goal cells of the maze.
+         * @param m the maze
+         * @param goals the goal cells
+         * @param numThreads the number of threads to use (0 meaning one per hardware thread)
+         * @throws OutOfBoundsCoordinates if a goal is outside of the maze
+         * @throws std::overflow_error if a distance cannot be represented by Distance
+         */
+        FlowField(const AbstractMaze &m, const CellCollection &goals, unsigned int numThreads = 0);
+
+        /**
+         * Recompute the entire flow field from scratch.
+         * Each thread runs a BFS over its own stripe of the maze, and the threads exchange the distances along the
+         * edges of their stripes until no more changes occur.
+         * @param numThreads the number of threads to use (0 meaning one per hardware thread)
+         * @throws std::overflow_error if a distance cannot be represented by Distance
+         */
+        void rebuild(unsigned int numThreads = 0);
+
+        /**
+         * Move the goals, updating the flow field incrementally.
+         * Cells that flowed to a removed goal are invalidated and recomputed from the cells around them, and the
+         * distances are then lowered around the added goals, so the work is proportional to the affected area.
+         * @param newGoals the new goal cells
+         * @throws OutOfBoundsCoordinates if a goal is outside of the maze
+         * @throws std::overflow_error if a distance cannot be represented by Distance
+         */
+        void setGoals(const CellCollection &newGoals);
+
+        inline const CellCollection &getGoals() const noexcept {
+            return goals;
+        }
+
+        /// The distance from a cell to the nearest goal, or Unreachable.
+        inline Distance distance(int x, int y) const noexcept {
+            return distances[y * width + x];
+        }
+
+        inline Distance distance(const Cell &c) const noexcept {
+            return distance(c.first, c.second);
+        }
+
+        /// The direction in which to move from a cell towards the nearest goal.
+        inline Direction direction(int x, int y) const noexcept {
+            const auto shift = 2 * (x % 4);
+            return static_cast<Direction>((directions[y * rowBytes + x / 4] >> shift) & 3);
+        }
+
+        inline Direction direction(const Cell &c) const noexcept {
+            return direction(c.first, c.second);
+        }
+
+        /// The raw distances, in row-major order.
+        inline const std::vector<Distance> &getDistances() const noexcept {
+            return distances;
+        }
+
+        /// The raw packed directions, four cells per byte, with each row occupying @see{getRowBytes} bytes.
+        inline const std::vector<std::uint8_t> &getDirections() const noexcept {
+            return directions;
+        }
+
+        inline int getRowBytes() const noexcept {
+            return rowBytes;
+        }
+
+    private:
+        /// Check the goals are in the maze, and return them sorted without duplicates.
+        const CellCollection checkGoals(const CellCollection &cs) const;
+
+        /// Determine the direction of a ranked cell from the distances of its neighbours.
+        void updateDirection(int rk) noexcept;
+
+        /// Recompute the directions of all the cells in the rows [y0, y1).
+        void updateDirections(int y0, int y1) noexcept;
+
+        /// The rank of the neighbour of a ranked cell in a direction, which must be a passage.
+        inline int step(const int rk, const int dir) const noexcept {
+            switch (dir) {
+                case 0:  return rk - width;
+                case 1:  return rk + 1;
+                case 2:  return rk + width;
+                default: return rk - 1;
+            }
+        }
+
+        const Dimensions2D dimensions;
+        const int width;
+        const int height;
+        const int rowBytes;
+
+        CellCollection goals;
+
+        /// The passages leaving each cell, as a bitmask indexed by dirIdx.
+        std::vector<std::uint8_t> passages;
+
+        std::vector<Distance> distances;
+        std::vector<std::uint8_t> directions;
+    };
+
+    using FlowField16 = FlowField<std::uint16_t>;
+    using FlowField32 = FlowField<std::uint32_t>;
+
+    extern template class FlowField<std::uint16_t>;
+    extern template class FlowField<std::uint32_t>;
+}
@@ -0,0 +1,140 @@
+/**
+ * IncrementalPathPlanner.cpp
+ *
+ * By Sebastian Raaphorst, 2018.
+ */
+
+#include <algorithm>
+#include <cstdlib>
+#include <vector>
+
+#include "AbstractMaze.h"
+#include "CommonMazeAttributes.h"
+#include "Exceptions.h"
+#include "IncrementalPathPlanner.h"
+
+namespace spelunker::types {
+    IncrementalPathPlanner::IncrementalPathPlanner(const AbstractMaze &m, const Cell &start, const Cell &goal)
+            : maze{&m},
+              width{m.getWidth()},
+              height{m.getHeight()},
+              start{(m.checkCell(start), start.second * m.getWidth() + start.first)},
+              last{this->start},
+              goal{(m.checkCell(goal), goal.second * m.getWidth() + goal.first)},
+              km{0},
+              g(width * height, Infinity),
+              rhs(width * height, Infinity),
+              queuedKey(width * height),
+              queued(width * height, false),
+              numExpansions{0} {
+        rhs[this->goal] = 0;
+        queuedKey[this->goal] = calculateKey(this->goal);
+        queued[this->goal] = true;
+        queue.emplace(queuedKey[this->goal], this->goal);
+    }
+
+    int IncrementalPathPlanner::heuristic(const int rk) const noexcept {
+        return std::abs(rk % width - start % width) + std::abs(rk / width - start / width);
+    }
+
+    IncrementalPathPlanner::Key IncrementalPathPlanner::calculateKey(const int rk) const noexcept {
+        const auto d = std::min(g[rk], rhs[rk]);
+        return Key{std::min(d + heuristic(rk) + km, Infinity), d};
+    }
+
+    std::vector<int> IncrementalPathPlanner::adjacent(const int rk) const {
+        std::vector<int> result;
+        const auto c = unrankCell(rk);
+        if (!maze->cellInBounds(c))
+            return result;
+        for (const auto &n: maze->neighbours(c))
+            result.emplace_back(rankCell(n));
+        return result;
+    }
+
+    void IncrementalPathPlanner::updateCell(const int rk) {
+        if (rk != goal) {
+            auto best = Infinity;
+            for (const auto n: adjacent(rk))
+                best = std::min(best, g[n] + 1);
+            rhs[rk] = std::min(best, Infinity);
+        }
+
+        if (queued[rk]) {
+            queue.erase(std::make_pair(queuedKey[rk], rk));
+            queued[rk] = false;
+        }
+        if (g[rk] != rhs[rk]) {
+            queuedKey[rk] = calculateKey(rk);
+            queued[rk] = true;
+            queue.emplace(queuedKey[rk], rk);
+        }
+    }
+
+    int IncrementalPathPlanner::computeShortestPath() {
+        while (!queue.empty() && (queue.begin()->first < calculateKey(start) || rhs[start] != g[start])) {
+            const auto [oldKey, u] = *queue.begin();
+            const auto newKey = calculateKey(u);
+            ++numExpansions;
+
+            if (oldKey < newKey) {
+                // The key is out of date since the start has moved: requeue with the correct key.
+                queue.erase(queue.begin());
+                queuedKey[u] = newKey;
+                queue.emplace(newKey, u);
+            } else if (g[u] > rhs[u]) {
+                // The cell is overconsistent: its distance has decreased, so settle it and propagate.
+                queue.erase(queue.begin());
+                queued[u] = false;
+                g[u] = rhs[u];
+                for (const auto n: adjacent(u))
+                    updateCell(n);
+            } else {
+                // The cell is underconsistent: its distance has increased, so invalidate it and its dependents.
+                g[u] = Infinity;
+                updateCell(u);
+                for (const auto n: adjacent(u))
+                    updateCell(n);
+            }
+        }
+        return rhs[start] >= Infinity ? -1 : rhs[start];
+    }
+
+    const CellCollection IncrementalPathPlanner::shortestPath() {
+        if (computeShortestPath() == -1)
+            return CellCollection{};
+
+        // Descend the distances to the goal, always stepping to a neighbour one move closer.
+        CellCollection path{unrankCell(start)};
+        for (auto cur = start; cur != goal;) {
+            const auto nbrs = adjacent(cur);
+            cur = *std::min_element(nbrs.cbegin(), nbrs.cend(), [this](int a, int b) { return g[a] < g[b]; });
+            path.emplace_back(unrankCell(cur));
+        }
+        return path;
+    }
+
+    void IncrementalPathPlanner::moveStart(const Cell &c) {
+        maze->checkCell(c);
+        start = rankCell(c);
+        km += std::abs(start % width - last % width) + std::abs(start / width - last / width);
+        last = start;
+    }
+
+    void IncrementalPathPlanner::updateMaze(const AbstractMaze &m, const CellCollection &changedCells) {
+        if (m.getWidth() != width || m.getHeight() != height)
+            throw IllegalDimensions(m.getWidth(), m.getHeight());
+        maze = &m;
+
+        // A change to a cell can alter the passages of the cells around it, so these must be updated as well.
+        for (const auto &c: changedCells) {
+            m.checkCell(c);
+            const auto [x, y] = c;
+            updateCell(rankCell(c));
+            if (x > 0)          updateCell(rankCell(cell(x - 1, y)));
+            if (x < width - 1)  updateCell(rankCell(cell(x + 1, y)));
+            if (y > 0)          updateCell(rankCell(cell(x, y - 1)));
+            if (y < height - 1) updateCell(rankCell(cell(x, y + 1)));
+        }
+    }
+}
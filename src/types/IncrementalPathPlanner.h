@@ -0,0 +1,123 @@
+/**
+ * IncrementalPathPlanner.h
+ *
+ * By Sebastian Raaphorst, 2018.
+ *
+ * An incremental shortest path planner (D* Lite) for mazes that change at runtime.
+ */
+
+#pragma once
+
+#include <climits>
+#include <set>
+#include <utility>
+#include <vector>
+
+#include "AbstractMaze.h"
+#include "CommonMazeAttributes.h"
+
+namespace spelunker::types {
+    /**
+     * A D* Lite planner, which maintains a shortest path from a start cell to a goal cell across changes to the maze.
+     *
+     * The planner searches backward from the goal, so that every cell it has settled knows its distance to the goal.
+     * When the maze changes, e.g. by toggling walls with {@see maze::Maze::toggleWalls} or cells with
+     * {@see thickmaze::ThickMaze::toggleCells}, only the cells whose distances are affected by the change are
+     * re-expanded, rather than running a full search from scratch. The start may also move, e.g. as an agent follows
+     * the path, without invalidating the work done.
+     *
+     * The planner keeps a reference to the maze it is planning over: the maze must outlive the planner, or be replaced
+     * with @see{updateMaze}.
+     */
+    class IncrementalPathPlanner final {
+    public:
+        /**
+         * Create a planner over the given maze. No search is performed until a path is requested.
+         * @param m the maze
+         * @param start the starting cell
+         * @param goal the goal cell
+         * @throws OutOfBoundsCoordinates if the start or goal are outside of the maze
+         */
+        IncrementalPathPlanner(const AbstractMaze &m, const Cell &start, const Cell &goal);
+
+        /**
+         * Compute, or repair, the shortest path, and return its length.
+         * @return the number of moves from the start to the goal, or -1 if the goal cannot be reached
+         */
+        int computeShortestPath();
+
+        /**
+         * Compute, or repair, the shortest path, and return it.
+         * @return the cells from the start to the goal inclusive, or an empty collection if there is no path
+         */
+        const CellCollection shortestPath();
+
+        /**
+         * Move the starting cell, e.g. as an agent walks along the path. The search tree remains valid.
+         * @param c the new starting cell
+         * @throws OutOfBoundsCoordinates if the cell is outside of the maze
+         */
+        void moveStart(const Cell &c);
+
+        /**
+         * Replace the maze with a modified version of it, and mark the cells whose passages have changed.
+         * The dimensions of the maze must not change. For a toggled wall in a Maze, either of the cells on each side
+         * of the wall may be specified; for a ThickMaze, the toggled cells themselves.
+         * @param m the modified maze
+         * @param changedCells the cells whose passages have changed
+         * @throws IllegalDimensions if the dimensions of the maze have changed
+         */
+        void updateMaze(const AbstractMaze &m, const CellCollection &changedCells);
+
+        /// The total number of cell expansions performed, as a measure of the work done by the planner.
+        inline long getNumExpansions() const noexcept {
+            return numExpansions;
+        }
+
+    private:
+        /// The priority of a cell in the queue, compared lexicographically.
+        using Key = std::pair<int, int>;
+
+        /// A distance representing that the goal cannot be reached.
+        static constexpr int Infinity = INT_MAX / 4;
+
+        int rankCell(const Cell &c) const noexcept {
+            return c.second * width + c.first;
+        }
+
+        Cell unrankCell(int rk) const noexcept {
+            return cell(rk % width, rk / width);
+        }
+
+        /// The Manhattan distance from the start to a cell, which never overestimates the distance in a grid maze.
+        int heuristic(int rk) const noexcept;
+
+        Key calculateKey(int rk) const noexcept;
+
+        /// Recalculate the one-step lookahead distance of a cell, and requeue it if it has become inconsistent.
+        void updateCell(int rk);
+
+        /// The ranks of the cells adjacent to a cell in the maze.
+        std::vector<int> adjacent(int rk) const;
+
+        const AbstractMaze *maze;
+        const int width;
+        const int height;
+        int start;
+        int last;
+        const int goal;
+
+        /// The key modifier, which accumulates the distance the start has moved so that queued keys stay valid.
+        int km;
+
+        std::vector<int> g;
+        std::vector<int> rhs;
+
+        /// The queue of inconsistent cells, and the key under which each cell is queued, if it is.
+        std::set<std::pair<Key, int>> queue;
+        std::vector<Key> queuedKey;
+        std::vector<bool> queued;
+
+        long numExpansions;
+    };
+}
@@ -0,0 +1,76 @@
+/**
+ * Parallel.cpp
+ *
+ * By Sebastian Raaphorst, 2018.
+ */
+
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+#include "Parallel.h"
+
+namespace spelunker::types {
+    TaskGroup::TaskGroup(const unsigned int numThreads) {
+        const auto n = numThreads == 0 ? defaultNumThreads() : numThreads;
+        threads.reserve(n - 1);
+        for (auto i = 1u; i < n; ++i)
+            threads.emplace_back([this] { work(); });
+    }
+
+    TaskGroup::~TaskGroup() {
+        wait();
+        {
+            std::lock_guard<std::mutex> lock{mutex};
+            shutdown = true;
+        }
+        changed.notify_all();
+        for (auto &t: threads)
+            t.join();
+    }
+
+    void TaskGroup::run(std::function<void()> task) {
+        {
+            std::lock_guard<std::mutex> lock{mutex};
+            tasks.emplace_back(std::move(task));
+            ++numUnfinished;
+        }
+        changed.notify_one();
+    }
+
+    void TaskGroup::wait() {
+        std::unique_lock<std::mutex> lock{mutex};
+        while (numUnfinished > 0) {
+            if (tasks.empty()) {
+                changed.wait(lock);
+                continue;
+            }
+
+            auto task = std::move(tasks.back());
+            tasks.pop_back();
+            lock.unlock();
+            task();
+            lock.lock();
+            if (--numUnfinished == 0)
+                changed.notify_all();
+        }
+    }
+
+    void TaskGroup::work() {
+        std::unique_lock<std::mutex> lock{mutex};
+        for (;;) {
+            changed.wait(lock, [this] { return shutdown || !tasks.empty(); });
+            if (shutdown)
+                return;
+
+            auto task = std::move(tasks.front());
+            tasks.pop_front();
+            lock.unlock();
+            task();
+            lock.lock();
+            if (--numUnfinished == 0)
+                changed.notify_all();
+        }
+    }
+}
@@ -0,0 +1,93 @@
+/**
+ * Parallel.h
+ *
+ * By Sebastian Raaphorst, 2018.
+ *
+ * Minimal threading helpers shared by the parallel maze algorithms.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace spelunker::types {
+    /// The number of threads to use when the caller does not specify one: one per hardware thread.
+    inline unsigned int defaultNumThreads() noexcept {
+        const auto n = std::thread::hardware_concurrency();
+        return n == 0 ? 1 : n;
+    }
+
+    /**
+     * Split the range [begin, end) into at most numThreads contiguous blocks and process each block in its own thread.
+     * The function is invoked as f(blockIdx, blockBegin, blockEnd). The calling thread processes block 0 itself, and
+     * this function does not return until all blocks have been processed.
+     * @param begin the start of the range
+     * @param end one past the end of the range
+     * @param numThreads the maximum number of threads to use (0 meaning @see{defaultNumThreads})
+     * @param f the function processing a block
+     * @return the number of blocks the range was split into
+     */
+    template<typename F>
+    unsigned int parallelFor(int begin, int end, unsigned int numThreads, F &&f) {
+        if (end <= begin)
+            return 0;
+        if (numThreads == 0)
+            numThreads = defaultNumThreads();
+
+        const auto size = end - begin;
+        const auto numBlocks = static_cast<int>(std::min<unsigned int>(numThreads, static_cast<unsigned int>(size)));
+        const auto blockBegin = [begin, size, numBlocks](int block) {
+            return begin + static_cast<int>(static_cast<long long>(size) * block / numBlocks);
+        };
+
+        std::vector<std::thread> threads;
+        threads.reserve(numBlocks - 1);
+        for (auto block = 1; block < numBlocks; ++block)
+            threads.emplace_back([&f, block, &blockBegin] { f(block, blockBegin(block), blockBegin(block + 1)); });
+        f(0, blockBegin(0), blockBegin(1));
+
+        for (auto &t: threads)
+            t.join();
+        return static_cast<unsigned int>(numBlocks);
+    }
+
+    /**
+     * A group of tasks run by a pool of threads, for divide-and-conquer algorithms: tasks may run further tasks.
+     * The waiting thread runs the most recently added, and hence smallest, pending tasks first, keeping the number of
+     * pending tasks small, while the threads of the pool take the oldest, and hence largest, ones, so that each steal
+     * hands a thread a substantial amount of work.
+     * Tasks must not throw.
+     */
+    class TaskGroup final {
+    public:
+        /// Create a group run by numThreads threads (0 meaning @see{defaultNumThreads}), including the waiting thread.
+        explicit TaskGroup(unsigned int numThreads = 0);
+        ~TaskGroup();
+
+        TaskGroup(const TaskGroup&) = delete;
+        TaskGroup &operator=(const TaskGroup&) = delete;
+
+        /// Run a task, possibly concurrently with the caller.
+        void run(std::function<void()> task);
+
+        /// Wait for all tasks, including any they have run, to finish, running pending tasks in the meantime.
+        void wait();
+
+    private:
+        /// Run pending tasks until the pool is shut down.
+        void work();
+
+        std::mutex mutex;
+        std::condition_variable changed;
+        std::deque<std::function<void()>> tasks;
+        int numUnfinished = 0;
+        bool shutdown = false;
+        std::vector<std::thread> threads;
+    };
+}